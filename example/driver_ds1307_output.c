@@ -57,6 +57,8 @@ uint8_t ds1307_output_init(void)
     DRIVER_DS1307_LINK_IIC_READ(&gs_handle, ds1307_interface_iic_read);
     DRIVER_DS1307_LINK_IIC_WRITE(&gs_handle, ds1307_interface_iic_write);
     DRIVER_DS1307_LINK_DELAY_MS(&gs_handle, ds1307_interface_delay_ms);
+    DRIVER_DS1307_LINK_GET_TICK_NS(&gs_handle, ds1307_interface_get_tick_ns);
+    DRIVER_DS1307_LINK_TRACE(&gs_handle, ds1307_interface_trace);
     DRIVER_DS1307_LINK_DEBUG_PRINT(&gs_handle, ds1307_interface_debug_print);
 
     /* init ds1307 */
@@ -137,31 +139,11 @@ uint8_t ds1307_output_set_time(ds1307_time_t *t)
  */
 uint8_t ds1307_output_set_timestamp(time_t timestamp)
 {
-    ds1307_time_t t;
-    struct tm *timeptr;
-
     /* convert times */
     timestamp += (time_t)(gs_time_zone * 3600);
-    timeptr = localtime(&timestamp);
-    t.am_pm = DS1307_AM;
-    t.date = (uint8_t)timeptr->tm_mday;
-    t.format = DS1307_FORMAT_24H;
-    t.hour = (uint8_t)timeptr->tm_hour;
-    t.minute = (uint8_t)timeptr->tm_min;
-    t.month = (uint8_t)timeptr->tm_mon + 1;
-    t.second = (uint8_t)timeptr->tm_sec;
-    if (timeptr->tm_wday == 0)
-    {
-        t.week  = 7;
-    }
-    else
-    {
-        t.week = (uint8_t)timeptr->tm_wday;
-    }
-    t.year = (uint16_t)(timeptr->tm_year + 1900);
 
-    /* set time */
-    if (ds1307_set_time(&gs_handle, &t) != 0)
+    /* set epoch */
+    if (ds1307_set_epoch(&gs_handle, (uint32_t)timestamp) != 0)
     {
         return 1;
     }
@@ -212,31 +194,16 @@ uint8_t ds1307_output_get_time(ds1307_time_t *t)
  */
 uint8_t ds1307_output_get_timestamp(time_t *timestamp)
 {
-    ds1307_time_t t;
-    struct tm timeptr;
+    uint32_t epoch;
 
-    /* get time */
-    if (ds1307_get_time(&gs_handle, &t) != 0)
+    /* get epoch */
+    if (ds1307_get_epoch(&gs_handle, &epoch) != 0)
     {
         return 1;
     }
-    timeptr.tm_year = t.year - 1900;
-    timeptr.tm_mon = t.month - 1;
-    timeptr.tm_wday = t.week;
-    timeptr.tm_mday = t.date;
-    if (t.format == DS1307_FORMAT_24H)
-    {
-        timeptr.tm_hour = t.hour;
-    }
-    else
-    {
-        timeptr.tm_hour = t.hour % 12 + t.am_pm * 12;
-    }
-    timeptr.tm_min = t.minute;
-    timeptr.tm_sec = t.second;
 
-    /* make time */
-    *timestamp = mktime(&timeptr) - gs_time_zone * 3600;
+    /* convert times */
+    *timestamp = (time_t)epoch - (time_t)(gs_time_zone * 3600);
 
     return 0;
 }
@@ -50,6 +50,15 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief ds1307 interface context structure definition
+ */
+typedef struct ds1307_interface_context_s
+{
+    char *name;        /**< iic bus name */
+    int fd;            /**< iic bus handle */
+} ds1307_interface_context_t;
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -94,6 +103,96 @@ uint8_t ds1307_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t ds1307_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     interface iic bus init with a context
+ * @param[in] *user pointer to a ds1307 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t ds1307_interface_iic_init_ctx(void *user);
+
+/**
+ * @brief     interface iic bus deinit with a context
+ * @param[in] *user pointer to a ds1307 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t ds1307_interface_iic_deinit_ctx(void *user);
+
+/**
+ * @brief      interface iic bus read with a context
+ * @param[in]  *user pointer to a ds1307 interface context structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ds1307_interface_iic_read_ctx(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     interface iic bus write with a context
+ * @param[in] *user pointer to a ds1307 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ds1307_interface_iic_write_ctx(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      interface iic bus read without blocking
+ * @param[in]  *user pointer to a ds1307 interface context structure or NULL
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[in]  *token completion token, passed back to ds1307_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read start failed
+ * @note       none
+ */
+uint8_t ds1307_interface_iic_read_async(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *token);
+
+/**
+ * @brief     interface iic bus write without blocking
+ * @param[in] *user pointer to a ds1307 interface context structure or NULL
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @param[in] *token completion token, passed back to ds1307_async_complete
+ * @return    status code
+ *            - 0 success
+ *            - 1 write start failed
+ * @note      none
+ */
+uint8_t ds1307_interface_iic_write_async(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *token);
+
+/**
+ * @brief     interface iic bus transfer of several messages
+ * @param[in] *user pointer to a ds1307 interface context structure or NULL
+ * @param[in] *msg pointer to a message array
+ * @param[in] len message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      none
+ */
+uint8_t ds1307_interface_iic_transfer(void *user, ds1307_iic_msg_t *msg, uint8_t len);
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -101,6 +200,30 @@ uint8_t ds1307_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
  */
 void ds1307_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief  interface get tick ns
+ * @return monotonic tick in ns
+ * @note   only needed by the time cache
+ */
+uint64_t ds1307_interface_get_tick_ns(void);
+
+/**
+ * @brief  interface stats tick
+ * @return free running 32 bit tick
+ * @note   only needed by the stats latency histograms
+ */
+uint32_t ds1307_interface_stats_tick(void);
+
+#if (DS1307_CONFIG_TRACE != 0)
+/**
+ * @brief     interface trace
+ * @param[in] *user pointer to a ds1307 interface context structure or NULL
+ * @param[in] *event pointer to a trace event structure
+ * @note      only needed by the trace
+ */
+void ds1307_interface_trace(void *user, ds1307_trace_t *event);
+#endif
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -35,8 +35,12 @@
  */
 
 #include "driver_ds1307_interface.h"
+#include "driver_ds1307_emulator.h"
 #include "iic.h"
+#include "trace.h"
+#include <pthread.h>
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -48,15 +52,47 @@
  */
 static int gs_fd;                           /**< iic handle */
 
+/**
+ * @brief async job queue length definition
+ */
+#define ASYNC_QUEUE_LEN 8        /**< 8 pending transfers */
+
+/**
+ * @brief async job structure definition
+ */
+typedef struct async_job_s
+{
+    void *user;          /**< interface context or NULL */
+    uint8_t read;        /**< 1 for read, 0 for write */
+    uint8_t addr;        /**< iic device write address */
+    uint8_t reg;         /**< iic register address */
+    uint8_t *buf;        /**< data buffer */
+    uint16_t len;        /**< data buffer length */
+    void *token;         /**< completion token */
+} async_job_t;
+
+static pthread_once_t gs_async_once = PTHREAD_ONCE_INIT;             /**< worker start once */
+static pthread_mutex_t gs_async_mutex = PTHREAD_MUTEX_INITIALIZER;   /**< queue mutex */
+static pthread_cond_t gs_async_cond = PTHREAD_COND_INITIALIZER;      /**< queue condition */
+static async_job_t gs_async_queue[ASYNC_QUEUE_LEN];                  /**< job queue */
+static uint32_t gs_async_head;                                       /**< queue head */
+static uint32_t gs_async_tail;                                       /**< queue tail */
+static uint8_t gs_async_started;                                     /**< worker started flag */
+
 /**
  * @brief  interface iic bus init
  * @return status code
  *         - 0 success
  *         - 1 iic init failed
- * @note   none
+ * @note   an attached emulator takes the place of the bus
  */
 uint8_t ds1307_interface_iic_init(void)
 {
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        return ds1307_emulator_iic_init();
+    }
+    
     return iic_init(IIC_DEVICE_NAME, &gs_fd);
 }
 
@@ -69,6 +105,11 @@ uint8_t ds1307_interface_iic_init(void)
  */
 uint8_t ds1307_interface_iic_deinit(void)
 {
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        return ds1307_emulator_iic_deinit();
+    }
+    
     return iic_deinit(gs_fd);
 }
 
@@ -85,6 +126,11 @@ uint8_t ds1307_interface_iic_deinit(void)
  */
 uint8_t ds1307_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        return ds1307_emulator_iic_read(addr, reg, buf, len);
+    }
+    
     return iic_read(gs_fd, addr, reg, buf, len);
 }
 
@@ -101,19 +147,366 @@ uint8_t ds1307_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t ds1307_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        return ds1307_emulator_iic_write(addr, reg, buf, len);
+    }
+    
     return iic_write(gs_fd, addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus init with a context
+ * @param[in] *user pointer to a ds1307 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      every context owns its own bus handle, so one process can drive
+ *            one chip on each /dev/i2c-N bus
+ */
+uint8_t ds1307_interface_iic_init_ctx(void *user)
+{
+    ds1307_interface_context_t *ctx = (ds1307_interface_context_t *)user;
+    
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        return ds1307_emulator_iic_init();
+    }
+    
+    return iic_init(ctx->name, &ctx->fd);
+}
+
+/**
+ * @brief     interface iic bus deinit with a context
+ * @param[in] *user pointer to a ds1307 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t ds1307_interface_iic_deinit_ctx(void *user)
+{
+    ds1307_interface_context_t *ctx = (ds1307_interface_context_t *)user;
+    
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        return ds1307_emulator_iic_deinit();
+    }
+    
+    return iic_deinit(ctx->fd);
+}
+
+/**
+ * @brief      interface iic bus read with a context
+ * @param[in]  *user pointer to a ds1307 interface context structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ds1307_interface_iic_read_ctx(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    ds1307_interface_context_t *ctx = (ds1307_interface_context_t *)user;
+    
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        return ds1307_emulator_iic_read(addr, reg, buf, len);
+    }
+    
+    return iic_read(ctx->fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief     interface iic bus write with a context
+ * @param[in] *user pointer to a ds1307 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ds1307_interface_iic_write_ctx(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    ds1307_interface_context_t *ctx = (ds1307_interface_context_t *)user;
+    
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        return ds1307_emulator_iic_write(addr, reg, buf, len);
+    }
+    
+    return iic_write(ctx->fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief     async worker thread
+ * @param[in] *arg unused
+ * @return    never returns
+ * @note      runs every queued transfer in order and reports it to the driver
+ */
+static void *a_async_worker(void *arg)
+{
+    async_job_t job;
+    ds1307_interface_context_t *ctx;
+    uint8_t res;
+    
+    (void)arg;
+    while (1)
+    {
+        pthread_mutex_lock(&gs_async_mutex);
+        while (gs_async_head == gs_async_tail)
+        {
+            pthread_cond_wait(&gs_async_cond, &gs_async_mutex);
+        }
+        job = gs_async_queue[gs_async_head % ASYNC_QUEUE_LEN];
+        gs_async_head++;
+        pthread_mutex_unlock(&gs_async_mutex);
+        
+        ctx = (ds1307_interface_context_t *)job.user;
+        if (job.read != 0)
+        {
+            res = iic_read((ctx != NULL) ? ctx->fd : gs_fd, job.addr, job.reg, job.buf, job.len);
+        }
+        else
+        {
+            res = iic_write((ctx != NULL) ? ctx->fd : gs_fd, job.addr, job.reg, job.buf, job.len);
+        }
+        (void)ds1307_async_complete((ds1307_handle_t *)job.token, res);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief start the async worker thread
+ * @note  none
+ */
+static void a_async_start(void)
+{
+    pthread_t thread;
+    
+    if (pthread_create(&thread, NULL, a_async_worker, NULL) == 0)
+    {
+        (void)pthread_detach(thread);
+        gs_async_started = 1;
+    }
+}
+
+/**
+ * @brief     queue an async transfer
+ * @param[in] *job pointer to an async job structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue failed
+ * @note      none
+ */
+static uint8_t a_async_queue(async_job_t *job)
+{
+    (void)pthread_once(&gs_async_once, a_async_start);
+    if (gs_async_started == 0)
+    {
+        return 1;
+    }
+    pthread_mutex_lock(&gs_async_mutex);
+    if (gs_async_tail - gs_async_head >= ASYNC_QUEUE_LEN)
+    {
+        pthread_mutex_unlock(&gs_async_mutex);
+        
+        return 1;
+    }
+    gs_async_queue[gs_async_tail % ASYNC_QUEUE_LEN] = *job;
+    gs_async_tail++;
+    pthread_cond_signal(&gs_async_cond);
+    pthread_mutex_unlock(&gs_async_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief      interface iic bus read without blocking
+ * @param[in]  *user pointer to a ds1307 interface context structure or NULL
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[in]  *token completion token, passed back to ds1307_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read start failed
+ * @note       the transfer runs on a worker thread that calls ds1307_async_complete,
+ *             an attached emulator completes it before returning
+ */
+uint8_t ds1307_interface_iic_read_async(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *token)
+{
+    async_job_t job;
+    
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        /* the emulator finishes at once */
+        return ds1307_async_complete((ds1307_handle_t *)token, ds1307_emulator_iic_read(addr, reg, buf, len));
+    }
+    
+    job.user = user;
+    job.read = 1;
+    job.addr = addr;
+    job.reg = reg;
+    job.buf = buf;
+    job.len = len;
+    job.token = token;
+    
+    return a_async_queue(&job);
+}
+
+/**
+ * @brief     interface iic bus write without blocking
+ * @param[in] *user pointer to a ds1307 interface context structure or NULL
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @param[in] *token completion token, passed back to ds1307_async_complete
+ * @return    status code
+ *            - 0 success
+ *            - 1 write start failed
+ * @note      the transfer runs on a worker thread that calls ds1307_async_complete,
+ *            an attached emulator completes it before returning
+ */
+uint8_t ds1307_interface_iic_write_async(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *token)
+{
+    async_job_t job;
+    
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        /* the emulator finishes at once */
+        return ds1307_async_complete((ds1307_handle_t *)token, ds1307_emulator_iic_write(addr, reg, buf, len));
+    }
+    
+    job.user = user;
+    job.read = 0;
+    job.addr = addr;
+    job.reg = reg;
+    job.buf = buf;
+    job.len = len;
+    job.token = token;
+    
+    return a_async_queue(&job);
+}
+
+/**
+ * @brief     interface iic bus transfer of several messages
+ * @param[in] *user pointer to a ds1307 interface context structure or NULL
+ * @param[in] *msg pointer to a message array
+ * @param[in] len message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      every message goes out in one I2C_RDWR ioctl
+ */
+uint8_t ds1307_interface_iic_transfer(void *user, ds1307_iic_msg_t *msg, uint8_t len)
+{
+    ds1307_interface_context_t *ctx = (ds1307_interface_context_t *)user;
+    iic_msg_t msgs[IIC_MAX_MSG];
+    uint8_t i;
+    
+    if (len > IIC_MAX_MSG)
+    {
+        return 1;
+    }
+    if (ds1307_emulator_get_attach() != 0)
+    {
+        return ds1307_emulator_iic_transfer(msg, len);
+    }
+    for (i = 0; i < len; i++)
+    {
+        msgs[i].addr = msg[i].addr;
+        msgs[i].read = (msg[i].flags == DS1307_IIC_MSG_READ) ? 1 : 0;
+        msgs[i].len = msg[i].len;
+        msgs[i].buf = msg[i].buf;
+    }
+    
+    return iic_transfer((ctx != NULL) ? ctx->fd : gs_fd, msgs, len);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
- * @note      none
+ * @note      an attached emulator on virtual time skips the wait
  */
 void ds1307_interface_delay_ms(uint32_t ms)
 {
+    if ((ds1307_emulator_get_attach() != 0) &&
+        (ds1307_emulator_get_clock() == DS1307_EMULATOR_CLOCK_VIRTUAL))
+    {
+        (void)ds1307_emulator_advance(1000000ULL * ms);
+        
+        return;
+    }
     usleep(1000 * ms);
 }
 
+/**
+ * @brief  interface get tick ns
+ * @return monotonic tick in ns
+ * @note   only needed by the time cache, follows the virtual time of an attached emulator
+ */
+uint64_t ds1307_interface_get_tick_ns(void)
+{
+    struct timespec ts;
+    
+    if ((ds1307_emulator_get_attach() != 0) &&
+        (ds1307_emulator_get_clock() == DS1307_EMULATOR_CLOCK_VIRTUAL))
+    {
+        return ds1307_emulator_get_tick_ns();
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  interface stats tick
+ * @return monotonic tick in ns, truncated to 32 bits
+ * @note   only needed by the stats latency histograms
+ */
+uint32_t ds1307_interface_stats_tick(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+#if (DS1307_CONFIG_TRACE != 0)
+/**
+ * @brief     interface trace
+ * @param[in] *user pointer to a ds1307 interface context structure or NULL
+ * @param[in] *event pointer to a trace event structure
+ * @note      writes chrome trace events when a trace file is open, a wait for the
+ *            bus lock of 1us or more shows up as its own slice
+ */
+void ds1307_interface_trace(void *user, ds1307_trace_t *event)
+{
+    ds1307_interface_context_t *ctx = (ds1307_interface_context_t *)user;
+    char args[96];
+    
+    if (event->start_ns - event->lock_ns >= 1000)
+    {
+        (void)trace_complete("bus lock", "ds1307", event->lock_ns, event->start_ns - event->lock_ns, NULL);
+    }
+    (void)snprintf(args, 96, "{\"bus\": \"%s\", \"reg\": \"0x%02X\", \"len\": %d, \"res\": %d}",
+                   (ctx != NULL) ? ctx->name : IIC_DEVICE_NAME, event->reg, event->len, event->res);
+    (void)trace_complete(event->api, (event->read != 0) ? "read" : "write",
+                         event->start_ns, event->end_ns - event->start_ns, args);
+}
+#endif
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -53,6 +53,22 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief iic max message definition
+ */
+#define IIC_MAX_MSG 42        /**< I2C_RDWR_IOCTL_MAX_MSGS */
+
+/**
+ * @brief iic message structure definition
+ */
+typedef struct iic_msg_s
+{
+    uint8_t addr;        /**< iic device write address */
+    uint8_t read;        /**< 1 for read, 0 for write */
+    uint16_t len;        /**< data length */
+    uint8_t *buf;        /**< data buffer */
+} iic_msg_t;
+
 /**
  * @brief      iic bus init
  * @param[in]  *name pointer to an iic device name buffer
@@ -156,6 +172,19 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     iic bus transfer of several messages
+ * @param[in] fd iic handle
+ * @param[in] *msg pointer to a message array
+ * @param[in] len message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      addr = device_address_7bits << 1, every message goes out in one
+ *            I2C_RDWR call with repeated starts, len <= IIC_MAX_MSG
+ */
+uint8_t iic_transfer(int fd, iic_msg_t *msg, uint32_t len);
+
 /**
  * @}
  */
@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      timepage.h
+ * @brief     timepage header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef TIMEPAGE_H
+#define TIMEPAGE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup timepage timepage function
+ * @brief    timepage function modules
+ * @{
+ */
+
+/**
+ * @brief timepage default definition
+ */
+#define TIMEPAGE_NAME           "/ds1307"               /**< default shared memory name */
+#define TIMEPAGE_SOCKET         "/run/ds1307.sock"      /**< default control socket path */
+#define TIMEPAGE_MAGIC          0x54503037U             /**< page magic */
+#define TIMEPAGE_VERSION        1                       /**< page layout version */
+
+/**
+ * @brief timepage flag enumeration definition
+ */
+typedef enum
+{
+    TIMEPAGE_FLAG_VALID  = 0x01,        /**< the time was read from the chip */
+    TIMEPAGE_FLAG_LOCKED = 0x02,        /**< the anchor sits on an observed second edge */
+    TIMEPAGE_FLAG_STALE  = 0x04,        /**< the last chip read failed */
+    TIMEPAGE_FLAG_HALTED = 0x08,        /**< the seconds of the chip stopped advancing */
+} timepage_flag_t;
+
+/**
+ * @brief timepage structure definition
+ * @note  the layout of the shared page, the daemon is the only writer,
+ *        seq is odd while an update is in flight
+ */
+typedef struct timepage_s
+{
+    uint32_t magic;                 /**< TIMEPAGE_MAGIC once the page is ready */
+    uint32_t version;               /**< TIMEPAGE_VERSION */
+    volatile uint32_t seq;          /**< update sequence */
+    uint32_t flags;                 /**< timepage_flag_t bits */
+    int64_t epoch;                  /**< unix seconds at the anchor */
+    uint64_t anchor_ns;             /**< CLOCK_MONOTONIC ns at which epoch began */
+    uint64_t update_ns;             /**< CLOCK_MONOTONIC ns of the last update */
+    uint32_t error_ns;              /**< anchor uncertainty in ns */
+    uint32_t pid;                   /**< daemon pid */
+} timepage_t;
+
+/**
+ * @brief timepage time structure definition
+ */
+typedef struct timepage_time_s
+{
+    int64_t sec;                    /**< unix seconds */
+    uint32_t nsec;                  /**< nanoseconds */
+    uint32_t flags;                 /**< timepage_flag_t bits */
+    uint32_t error_ns;              /**< uncertainty in ns */
+    uint64_t age_ns;                /**< ns since the last update of the daemon */
+} timepage_time_t;
+
+/**
+ * @brief timepage client structure definition
+ */
+typedef struct timepage_client_s
+{
+    const volatile timepage_t *page;        /**< mapped page */
+} timepage_client_t;
+
+/**
+ * @brief     timepage create
+ * @param[in] *name pointer to a shared memory name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ * @note      daemon side, maps the page read write and marks it ready
+ */
+uint8_t timepage_create(const char *name);
+
+/**
+ * @brief     timepage publish
+ * @param[in] epoch unix seconds at the anchor
+ * @param[in] anchor_ns CLOCK_MONOTONIC ns at which epoch began
+ * @param[in] error_ns anchor uncertainty in ns
+ * @param[in] flags timepage_flag_t bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ * @note      daemon side, single writer
+ */
+uint8_t timepage_publish(int64_t epoch, uint64_t anchor_ns, uint32_t error_ns, uint32_t flags);
+
+/**
+ * @brief  timepage destroy
+ * @return status code
+ *         - 0 success
+ *         - 1 destroy failed
+ * @note   daemon side, unmaps and unlinks the page
+ */
+uint8_t timepage_destroy(void);
+
+/**
+ * @brief     timepage open
+ * @param[in] *client pointer to a timepage client structure
+ * @param[in] *name pointer to a shared memory name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 client or name is NULL
+ *            - 4 page is not ready
+ * @note      client side, maps the page read only
+ */
+uint8_t timepage_open(timepage_client_t *client, const char *name);
+
+/**
+ * @brief      timepage read
+ * @param[in]  *client pointer to a timepage client structure
+ * @param[out] *t pointer to a timepage time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 client or t is NULL
+ *             - 3 client is not opened
+ *             - 4 page holds no valid time
+ * @note       client side, no syscall, the time is the anchor extrapolated on CLOCK_MONOTONIC
+ */
+uint8_t timepage_read(timepage_client_t *client, timepage_time_t *t);
+
+/**
+ * @brief     timepage close
+ * @param[in] *client pointer to a timepage client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ *            - 2 client is NULL
+ *            - 3 client is not opened
+ * @note      client side
+ */
+uint8_t timepage_close(timepage_client_t *client);
+
+/**
+ * @brief      timepage control
+ * @param[in]  *path pointer to a control socket path buffer
+ * @param[in]  *cmd pointer to a command buffer
+ * @param[out] *reply pointer to a reply buffer
+ * @param[in]  len reply buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 control failed
+ *             - 2 path, cmd or reply is NULL
+ * @note       client side, sends one command line and reads the reply line,
+ *             commands are time, set-time <epoch>, read-ram <addr> <len> and write-ram <addr> <hex>
+ */
+uint8_t timepage_control(const char *path, const char *cmd, char *reply, uint16_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
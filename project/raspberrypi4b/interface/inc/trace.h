@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      trace.h
+ * @brief     trace header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup trace trace function
+ * @brief    trace function modules
+ * @{
+ */
+
+/**
+ * @brief     trace init
+ * @param[in] *name pointer to a trace file name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the file is written in the chrome trace event json array format
+ */
+uint8_t trace_init(char *name);
+
+/**
+ * @brief  trace deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   closes the json array, a file left open by a crash still loads
+ */
+uint8_t trace_deinit(void);
+
+/**
+ * @brief     write a complete event
+ * @param[in] *name pointer to an event name buffer
+ * @param[in] *cat pointer to an event category buffer
+ * @param[in] ts_ns start time in ns
+ * @param[in] dur_ns duration in ns
+ * @param[in] *args pointer to a json object buffer or NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      thread safe, every event carries the pid and the tid of the caller
+ */
+uint8_t trace_complete(const char *name, const char *cat, uint64_t ts_ns, uint64_t dur_ns, const char *args);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio.c
+ * @brief     gpio source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "gpio.h"
+#include <gpiod.h>
+#include <pthread.h>
+
+/**
+ * @brief gpio device name definition
+ * @note  override it to run against a gpio-sim chip
+ */
+#ifndef GPIO_DEVICE_NAME
+    #define GPIO_DEVICE_NAME "/dev/gpiochip0"        /**< gpio device name */
+#endif
+
+/**
+ * @brief gpio device line definition
+ */
+#ifndef GPIO_DEVICE_LINE
+    #define GPIO_DEVICE_LINE 17                      /**< gpio device line */
+#endif
+
+/**
+ * @brief global gpio irq function pointer
+ */
+extern uint8_t (*g_gpio_irq)(void);
+
+/**
+ * @brief gpio device handle definition
+ */
+static struct gpiod_chip *gs_chip;        /**< gpio chip handle */
+static struct gpiod_line *gs_line;        /**< gpio line handle */
+static pthread_t gs_pid;                  /**< gpio thread pid */
+
+/**
+ * @brief     gpio interrupt thread
+ * @param[in] *p pointer to an args buffer
+ * @note      none
+ */
+static void *a_gpio_interrupt_pthread(void *p)
+{
+    const struct timespec ts = {1, 0};
+    struct gpiod_line_event event;
+    
+    (void)p;
+    
+    /* enable cancel */
+    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+    
+    /* set cancel type */
+    pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, NULL);
+    
+    while (1)
+    {
+        /* cancel point */
+        pthread_testcancel();
+        
+        /* wait the event */
+        if (gpiod_line_event_wait(gs_line, &ts) == 1)
+        {
+            /* read the event */
+            if (gpiod_line_event_read(gs_line, &event) == 0)
+            {
+                /* check the falling edge */
+                if ((event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE) && (g_gpio_irq != NULL))
+                {
+                    /* run the irq */
+                    (void)g_gpio_irq();
+                }
+            }
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief  gpio interrupt init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the falling edge events of the line call g_gpio_irq
+ */
+uint8_t gpio_interrupt_init(void)
+{
+    /* open the gpio chip */
+    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    if (gs_chip == NULL)
+    {
+        perror("gpio: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* get the line */
+    gs_line = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE);
+    if (gs_line == NULL)
+    {
+        perror("gpio: get line failed.\n");
+        gpiod_chip_close(gs_chip);
+        
+        return 1;
+    }
+    
+    /* request the falling edge events */
+    if (gpiod_line_request_falling_edge_events(gs_line, "gpio_interrupt") < 0)
+    {
+        perror("gpio: request falling edge events failed.\n");
+        gpiod_chip_close(gs_chip);
+        
+        return 1;
+    }
+    
+    /* create the thread */
+    if (pthread_create(&gs_pid, NULL, a_gpio_interrupt_pthread, NULL) != 0)
+    {
+        perror("gpio: create pthread failed.\n");
+        gpiod_line_release(gs_line);
+        gpiod_chip_close(gs_chip);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio interrupt deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t gpio_interrupt_deinit(void)
+{
+    /* stop the thread */
+    if (pthread_cancel(gs_pid) != 0)
+    {
+        perror("gpio: delete pthread failed.\n");
+        
+        return 1;
+    }
+    (void)pthread_join(gs_pid, NULL);
+    
+    /* release the line */
+    gpiod_line_release(gs_line);
+    
+    /* close the chip */
+    gpiod_chip_close(gs_chip);
+    
+    return 0;
+}
@@ -39,6 +39,54 @@
 #include <linux/i2c-dev.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>
+#include <errno.h>
+
+/**
+ * @brief iic usdt definition
+ * @note  build with -DIIC_USDT=1 to place sys/sdt.h probes around every I2C_RDWR ioctl
+ */
+#ifndef IIC_USDT
+    #define IIC_USDT 0        /**< disable the probes */
+#endif
+
+/**
+ * @brief iic probe definition
+ */
+#if (IIC_USDT != 0)
+    #include <sys/sdt.h>
+    #define IIC_PROBE_START(ADDR, REG, LEN)          DTRACE_PROBE3(iic, rdwr_start, ADDR, REG, LEN)
+    #define IIC_PROBE_DONE(ADDR, REG, LEN, ERR)      DTRACE_PROBE4(iic, rdwr_done, ADDR, REG, LEN, ERR)
+#else
+    #define IIC_PROBE_START(ADDR, REG, LEN)
+    #define IIC_PROBE_DONE(ADDR, REG, LEN, ERR)      (void)(REG), (void)(LEN), (void)(ERR)
+#endif
+
+/**
+ * @brief     run one I2C_RDWR ioctl
+ * @param[in] fd iic handle
+ * @param[in] *data pointer to an ioctl data structure
+ * @param[in] reg register address, -1 when there is none
+ * @param[in] len data length
+ * @return    ioctl result
+ * @note      the probes carry the device address, the register, the length and the errno
+ */
+static int a_iic_rdwr(int fd, struct i2c_rdwr_ioctl_data *data, int reg, int len)
+{
+    int res;
+    int err;
+    
+    /* probe the start */
+    IIC_PROBE_START(data->msgs[0].addr, reg, len);
+    
+    /* transmit */
+    res = ioctl(fd, I2C_RDWR, data);
+    err = (res < 0) ? errno : 0;
+    
+    /* probe the end */
+    IIC_PROBE_DONE(data->msgs[0].addr, reg, len, err);
+    
+    return res;
+}
 
 /**
  * @brief      iic bus init
@@ -121,7 +169,7 @@ uint8_t iic_read_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
     i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data, -1, len) < 0)
     {
         perror("iic: read failed.\n");
         
@@ -167,7 +215,7 @@ uint8_t iic_read(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     i2c_rdwr_data.nmsgs = 2;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data, reg, len) < 0)
     {
         perror("iic: read failed.\n");
         
@@ -216,7 +264,7 @@ uint8_t iic_read_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uin
     i2c_rdwr_data.nmsgs = 2;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data, reg, len) < 0)
     {
         perror("iic: read failed.\n");
         
@@ -257,7 +305,7 @@ uint8_t iic_write_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
     i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data, -1, len) < 0)
     {
         perror("iic: write failed.\n");
         
@@ -305,7 +353,7 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data, reg, len) < 0)
     {
         perror("iic: write failed.\n");
         
@@ -354,7 +402,7 @@ uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, ui
     i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data, reg, len) < 0)
     {
         perror("iic: write failed.\n");
         
@@ -363,3 +411,61 @@ uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, ui
      
     return 0;
 }
+
+/**
+ * @brief     iic bus transfer of several messages
+ * @param[in] fd iic handle
+ * @param[in] *msg pointer to a message array
+ * @param[in] len message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      addr = device_address_7bits << 1, every message goes out in one
+ *            I2C_RDWR call with repeated starts, len <= IIC_MAX_MSG
+ */
+uint8_t iic_transfer(int fd, iic_msg_t *msg, uint32_t len)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    struct i2c_msg msgs[IIC_MAX_MSG];
+    uint32_t i;
+    int reg;
+    int total;
+    
+    /* check the length */
+    if ((len == 0) || (len > IIC_MAX_MSG))
+    {
+        return 1;
+    }
+    
+    /* clear ioctl data */
+    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
+    
+    /* clear msgs data */
+    memset(msgs, 0, sizeof(struct i2c_msg) * len);
+    
+    /* set the param */
+    total = 0;
+    for (i = 0; i < len; i++)
+    {
+        total += msg[i].len;
+        msgs[i].addr = msg[i].addr >> 1;
+        msgs[i].flags = (msg[i].read != 0) ? I2C_M_RD : 0;
+        msgs[i].buf = msg[i].buf;
+        msgs[i].len = msg[i].len;
+    }
+    i2c_rdwr_data.msgs = msgs;
+    i2c_rdwr_data.nmsgs = len;
+    
+    /* the first written byte is the register */
+    reg = ((msg[0].read == 0) && (msg[0].len != 0)) ? msg[0].buf[0] : -1;
+    
+    /* transmit */
+    if (a_iic_rdwr(fd, &i2c_rdwr_data, reg, total) < 0)
+    {
+        perror("iic: transfer failed.\n");
+        
+        return 1;
+    }
+     
+    return 0;
+}
@@ -0,0 +1,408 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      timepage.c
+ * @brief     timepage source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "timepage.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * @brief timepage read retry definition
+ */
+#define TIMEPAGE_READ_RETRY        1000        /**< seqlock retries before giving up */
+
+/**
+ * @brief global var definition
+ */
+static timepage_t *gs_page = NULL;        /**< daemon page */
+static char gs_name[64];                  /**< daemon page name */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   served by the vdso, no syscall
+ */
+static uint64_t a_timepage_now(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     timepage create
+ * @param[in] *name pointer to a shared memory name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ * @note      daemon side, maps the page read write and marks it ready
+ */
+uint8_t timepage_create(const char *name)
+{
+    int fd;
+    void *page;
+    
+    fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        perror("timepage: shm_open failed.\n");
+        
+        return 1;
+    }
+    if (ftruncate(fd, (off_t)sysconf(_SC_PAGESIZE)) != 0)
+    {
+        perror("timepage: ftruncate failed.\n");
+        (void)close(fd);
+        (void)shm_unlink(name);
+        
+        return 1;
+    }
+    page = mmap(NULL, (size_t)sysconf(_SC_PAGESIZE), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (page == MAP_FAILED)
+    {
+        perror("timepage: mmap failed.\n");
+        (void)shm_unlink(name);
+        
+        return 1;
+    }
+    gs_page = (timepage_t *)page;
+    snprintf(gs_name, sizeof(gs_name), "%s", name);
+    
+    /* an old page may still be mapped by the clients, so hide it before clearing */
+    gs_page->magic = 0;
+    __sync_synchronize();
+    gs_page->seq++;
+    __sync_synchronize();
+    gs_page->version = TIMEPAGE_VERSION;
+    gs_page->flags = 0;
+    gs_page->epoch = 0;
+    gs_page->anchor_ns = 0;
+    gs_page->update_ns = a_timepage_now();
+    gs_page->error_ns = 0;
+    gs_page->pid = (uint32_t)getpid();
+    __sync_synchronize();
+    gs_page->seq++;
+    __sync_synchronize();
+    gs_page->magic = TIMEPAGE_MAGIC;
+    
+    return 0;
+}
+
+/**
+ * @brief     timepage publish
+ * @param[in] epoch unix seconds at the anchor
+ * @param[in] anchor_ns CLOCK_MONOTONIC ns at which epoch began
+ * @param[in] error_ns anchor uncertainty in ns
+ * @param[in] flags timepage_flag_t bits
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ * @note      daemon side, single writer
+ */
+uint8_t timepage_publish(int64_t epoch, uint64_t anchor_ns, uint32_t error_ns, uint32_t flags)
+{
+    if (gs_page == NULL)
+    {
+        return 1;
+    }
+    
+    /* odd while the fields change */
+    gs_page->seq++;
+    __sync_synchronize();
+    gs_page->flags = flags;
+    gs_page->epoch = epoch;
+    gs_page->anchor_ns = anchor_ns;
+    gs_page->update_ns = a_timepage_now();
+    gs_page->error_ns = error_ns;
+    __sync_synchronize();
+    gs_page->seq++;
+    
+    return 0;
+}
+
+/**
+ * @brief  timepage destroy
+ * @return status code
+ *         - 0 success
+ *         - 1 destroy failed
+ * @note   daemon side, unmaps and unlinks the page
+ */
+uint8_t timepage_destroy(void)
+{
+    uint8_t res;
+    
+    if (gs_page == NULL)
+    {
+        return 1;
+    }
+    
+    /* the clients that keep the mapping see a page that is not ready */
+    gs_page->magic = 0;
+    __sync_synchronize();
+    res = (munmap(gs_page, (size_t)sysconf(_SC_PAGESIZE)) == 0) ? 0 : 1;
+    if (shm_unlink(gs_name) != 0)
+    {
+        res = 1;
+    }
+    gs_page = NULL;
+    
+    return res;
+}
+
+/**
+ * @brief     timepage open
+ * @param[in] *client pointer to a timepage client structure
+ * @param[in] *name pointer to a shared memory name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 client or name is NULL
+ *            - 4 page is not ready
+ * @note      client side, maps the page read only
+ */
+uint8_t timepage_open(timepage_client_t *client, const char *name)
+{
+    int fd;
+    void *page;
+    
+    if ((client == NULL) || (name == NULL))
+    {
+        return 2;
+    }
+    
+    client->page = NULL;
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    page = mmap(NULL, (size_t)sysconf(_SC_PAGESIZE), PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (page == MAP_FAILED)
+    {
+        return 1;
+    }
+    if ((((const volatile timepage_t *)page)->magic != TIMEPAGE_MAGIC) ||
+        (((const volatile timepage_t *)page)->version != TIMEPAGE_VERSION))
+    {
+        (void)munmap(page, (size_t)sysconf(_SC_PAGESIZE));
+        
+        return 4;
+    }
+    client->page = (const volatile timepage_t *)page;
+    
+    return 0;
+}
+
+/**
+ * @brief      timepage read
+ * @param[in]  *client pointer to a timepage client structure
+ * @param[out] *t pointer to a timepage time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 client or t is NULL
+ *             - 3 client is not opened
+ *             - 4 page holds no valid time
+ * @note       client side, no syscall, the time is the anchor extrapolated on CLOCK_MONOTONIC
+ */
+uint8_t timepage_read(timepage_client_t *client, timepage_time_t *t)
+{
+    const volatile timepage_t *page;
+    uint32_t seq;
+    uint32_t i;
+    uint32_t flags;
+    int64_t epoch;
+    uint64_t anchor_ns;
+    uint64_t update_ns;
+    uint32_t error_ns;
+    uint64_t now;
+    uint64_t elapsed;
+    
+    if ((client == NULL) || (t == NULL))
+    {
+        return 2;
+    }
+    if (client->page == NULL)
+    {
+        return 3;
+    }
+    
+    /* copy a consistent snapshot */
+    page = client->page;
+    for (i = 0; i < TIMEPAGE_READ_RETRY; i++)
+    {
+        seq = page->seq;
+        if ((seq & 1) != 0)
+        {
+            continue;
+        }
+        __sync_synchronize();
+        flags = page->flags;
+        epoch = page->epoch;
+        anchor_ns = page->anchor_ns;
+        update_ns = page->update_ns;
+        error_ns = page->error_ns;
+        __sync_synchronize();
+        if ((page->seq == seq) && (page->magic == TIMEPAGE_MAGIC))
+        {
+            break;
+        }
+    }
+    if (i == TIMEPAGE_READ_RETRY)
+    {
+        return 1;
+    }
+    if ((flags & TIMEPAGE_FLAG_VALID) == 0)
+    {
+        return 4;
+    }
+    
+    /* extrapolate from the anchor */
+    now = a_timepage_now();
+    elapsed = (now > anchor_ns) ? (now - anchor_ns) : 0;
+    t->sec = epoch + (int64_t)(elapsed / 1000000000ULL);
+    t->nsec = (uint32_t)(elapsed % 1000000000ULL);
+    t->flags = flags;
+    t->error_ns = error_ns;
+    t->age_ns = (now > update_ns) ? (now - update_ns) : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     timepage close
+ * @param[in] *client pointer to a timepage client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ *            - 2 client is NULL
+ *            - 3 client is not opened
+ * @note      client side
+ */
+uint8_t timepage_close(timepage_client_t *client)
+{
+    uint8_t res;
+    
+    if (client == NULL)
+    {
+        return 2;
+    }
+    if (client->page == NULL)
+    {
+        return 3;
+    }
+    
+    res = (munmap((void *)client->page, (size_t)sysconf(_SC_PAGESIZE)) == 0) ? 0 : 1;
+    client->page = NULL;
+    
+    return res;
+}
+
+/**
+ * @brief      timepage control
+ * @param[in]  *path pointer to a control socket path buffer
+ * @param[in]  *cmd pointer to a command buffer
+ * @param[out] *reply pointer to a reply buffer
+ * @param[in]  len reply buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 control failed
+ *             - 2 path, cmd or reply is NULL
+ * @note       client side, sends one command line and reads the reply line,
+ *             commands are time, set-time <epoch>, read-ram <addr> <len> and write-ram <addr> <hex>
+ */
+uint8_t timepage_control(const char *path, const char *cmd, char *reply, uint16_t len)
+{
+    int fd;
+    struct sockaddr_un addr;
+    ssize_t n;
+    uint16_t pos;
+    
+    if ((path == NULL) || (cmd == NULL) || (reply == NULL) || (len == 0))
+    {
+        return 2;
+    }
+    
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    if ((write(fd, cmd, strlen(cmd)) < 0) || (write(fd, "\n", 1) != 1))
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    
+    /* the daemon closes the connection after the reply line */
+    pos = 0;
+    while (pos < len - 1)
+    {
+        n = read(fd, reply + pos, len - 1 - pos);
+        if (n <= 0)
+        {
+            break;
+        }
+        pos += (uint16_t)n;
+    }
+    (void)close(fd);
+    reply[pos] = 0;
+    if ((pos != 0) && (reply[pos - 1] == '\n'))
+    {
+        reply[pos - 1] = 0;
+    }
+    
+    return (pos != 0) ? 0 : 1;
+}
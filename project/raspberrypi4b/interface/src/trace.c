@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      trace.c
+ * @brief     trace source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "trace.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+/**
+ * @brief global var definition
+ */
+static FILE *gs_file = NULL;                                       /**< trace file */
+static uint32_t gs_count = 0;                                      /**< written event number */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;       /**< file mutex */
+
+/**
+ * @brief     trace init
+ * @param[in] *name pointer to a trace file name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the file is written in the chrome trace event json array format
+ */
+uint8_t trace_init(char *name)
+{
+    FILE *file;
+    
+    file = fopen(name, "w");
+    if (file == NULL)
+    {
+        perror("trace: open failed.\n");
+        
+        return 1;
+    }
+    fprintf(file, "[\n");
+    
+    pthread_mutex_lock(&gs_mutex);
+    gs_file = file;
+    gs_count = 0;
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief  trace deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   closes the json array, a file left open by a crash still loads
+ */
+uint8_t trace_deinit(void)
+{
+    uint8_t res;
+    
+    pthread_mutex_lock(&gs_mutex);
+    if (gs_file == NULL)
+    {
+        pthread_mutex_unlock(&gs_mutex);
+        
+        return 1;
+    }
+    fprintf(gs_file, "\n]\n");
+    res = (fclose(gs_file) == 0) ? 0 : 1;
+    gs_file = NULL;
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return res;
+}
+
+/**
+ * @brief     write a complete event
+ * @param[in] *name pointer to an event name buffer
+ * @param[in] *cat pointer to an event category buffer
+ * @param[in] ts_ns start time in ns
+ * @param[in] dur_ns duration in ns
+ * @param[in] *args pointer to a json object buffer or NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      thread safe, every event carries the pid and the tid of the caller
+ */
+uint8_t trace_complete(const char *name, const char *cat, uint64_t ts_ns, uint64_t dur_ns, const char *args)
+{
+    long tid;
+    
+    tid = (long)syscall(SYS_gettid);
+    pthread_mutex_lock(&gs_mutex);
+    if (gs_file == NULL)
+    {
+        pthread_mutex_unlock(&gs_mutex);
+        
+        return 1;
+    }
+    
+    /* ts and dur are in us */
+    fprintf(gs_file, "%s{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %llu.%03u, \"dur\": %llu.%03u, "
+            "\"pid\": %ld, \"tid\": %ld, \"args\": %s}",
+            (gs_count != 0) ? ",\n" : "", name, cat,
+            (unsigned long long)(ts_ns / 1000), (unsigned int)(ts_ns % 1000),
+            (unsigned long long)(dur_ns / 1000), (unsigned int)(dur_ns % 1000),
+            (long)getpid(), tid, (args != NULL) ? args : "{}");
+    gs_count++;
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      log.c
+ * @brief     log decoder source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1307.h"
+#include <stdlib.h>
+
+#if (DS1307_CONFIG_LOG_BINARY == 0)
+#error "the log decoder needs DS1307_CONFIG_LOG_BINARY=1"
+#endif
+
+/**
+ * @brief log decoder max entry definition
+ */
+#define LOG_MAX_ENTRY        65536        /**< max entries of one dump */
+
+/**
+ * @brief     compare two log entries by sequence
+ * @param[in] *a pointer to the first entry
+ * @param[in] *b pointer to the second entry
+ * @return    compare result
+ * @note      none
+ */
+static int a_log_compare(const void *a, const void *b)
+{
+    const ds1307_log_entry_t *x = (const ds1307_log_entry_t *)a;
+    const ds1307_log_entry_t *y = (const ds1307_log_entry_t *)b;
+    
+    return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      ds1307_log [file], the file is a raw dump of a log ring from any little endian target,
+ *            stdin is read without a file, the entries are printed oldest first
+ */
+int main(int argc, char **argv)
+{
+    FILE *f;
+    ds1307_log_entry_t *entry;
+    size_t num;
+    size_t i;
+    size_t valid;
+    const char *text;
+    char line[128];
+    size_t len;
+    
+    /* open the dump */
+    f = stdin;
+    if (argc > 1)
+    {
+        f = fopen(argv[1], "rb");
+        if (f == NULL)
+        {
+            perror("ds1307_log: open failed");
+            
+            return 1;
+        }
+    }
+    
+    /* read all entries */
+    entry = (ds1307_log_entry_t *)malloc(sizeof(ds1307_log_entry_t) * LOG_MAX_ENTRY);
+    if (entry == NULL)
+    {
+        if (f != stdin)
+        {
+            (void)fclose(f);
+        }
+        
+        return 1;
+    }
+    num = fread(entry, sizeof(ds1307_log_entry_t), LOG_MAX_ENTRY, f);
+    if (f != stdin)
+    {
+        (void)fclose(f);
+    }
+    
+    /* drop the unused and the half written entries */
+    valid = 0;
+    for (i = 0; i < num; i++)
+    {
+        if (entry[i].seq != 0)
+        {
+            entry[valid] = entry[i];
+            valid++;
+        }
+    }
+    
+    /* sort the ring oldest first */
+    qsort(entry, valid, sizeof(ds1307_log_entry_t), a_log_compare);
+    
+    /* print every entry */
+    for (i = 0; i < valid; i++)
+    {
+        if (ds1307_log_get_text(entry[i].id, &text) != 0)
+        {
+            (void)printf("%10u %10u.%03u ms  unknown id 0x%04X, arg %u\n", entry[i].seq,
+                         entry[i].tick / 1000, entry[i].tick % 1000, entry[i].id, entry[i].arg);
+            
+            continue;
+        }
+        (void)strncpy(line, text, sizeof(line) - 1);
+        line[sizeof(line) - 1] = '\0';
+        len = strlen(line);
+        if ((len > 0) && (line[len - 1] == '\n'))
+        {
+            line[len - 1] = '\0';
+        }
+        if (entry[i].arg != 0)
+        {
+            (void)printf("%10u %10u.%03u ms  %s arg %u\n", entry[i].seq,
+                         entry[i].tick / 1000, entry[i].tick % 1000, line, entry[i].arg);
+        }
+        else
+        {
+            (void)printf("%10u %10u.%03u ms  %s\n", entry[i].seq,
+                         entry[i].tick / 1000, entry[i].tick % 1000, line);
+        }
+    }
+    free(entry);
+    
+    return 0;
+}
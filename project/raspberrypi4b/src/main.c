@@ -37,11 +37,544 @@
 #include "driver_ds1307_register_test.h"
 #include "driver_ds1307_ram_test.h"
 #include "driver_ds1307_output_test.h"
+#include "driver_ds1307_sqw_test.h"
+#include "driver_ds1307_async_test.h"
+#include "driver_ds1307_bench.h"
+#include "driver_ds1307_emulator.h"
 #include "driver_ds1307_basic.h"
 #include "driver_ds1307_output.h"
+#include "gpio.h"
+#include "trace.h"
+#include "timepage.h"
 #include <getopt.h>
 #include <stdlib.h>
 #include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * @brief global var definition
+ */
+uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq */
+
+/**
+ * @brief daemon drift definition
+ * @note  crystal tolerance and aging of the chip plus the error of the host tick
+ */
+#define DAEMON_DRIFT_PPM        200        /**< anchor error growth */
+
+/**
+ * @brief daemon test skew definition
+ * @note  a fast crystal within the drift the daemon allows for
+ */
+#define DAEMON_TEST_SKEW_PPM        150        /**< chip skew of the daemon test */
+
+/**
+ * @brief daemon state structure definition
+ */
+typedef struct daemon_state_s
+{
+    int64_t epoch;             /**< unix seconds at the anchor */
+    uint64_t anchor_ns;        /**< tick at which epoch began */
+    uint32_t error_ns;         /**< anchor uncertainty in ns */
+    uint32_t flags;            /**< timepage flags */
+    int64_t second;            /**< last read seconds */
+    uint64_t last_ns;          /**< tick at the start of the last read */
+    uint64_t change_ns;        /**< tick of the last seconds change */
+} daemon_state_t;
+
+/**
+ * @brief daemon var definition
+ */
+static volatile sig_atomic_t gs_daemon_stop = 0;        /**< stop request */
+
+/**
+ * @brief     daemon signal handler
+ * @param[in] sig signal number
+ * @note      none
+ */
+static void a_daemon_signal(int sig)
+{
+    (void)sig;
+    gs_daemon_stop = 1;
+}
+
+/**
+ * @brief     daemon anchor error
+ * @param[in] *state pointer to a daemon state structure
+ * @param[in] now tick in ns
+ * @return    error in ns
+ * @note      the error of the anchor grows by the worst drift since it was taken
+ */
+static uint32_t a_daemon_error(daemon_state_t *state, uint64_t now)
+{
+    uint64_t error_ns;
+
+    error_ns = (now > state->anchor_ns) ? (now - state->anchor_ns) / (1000000ULL / DAEMON_DRIFT_PPM) : 0;
+    error_ns += state->error_ns;
+
+    return (error_ns < 1000000000ULL) ? (uint32_t)error_ns : 1000000000U;
+}
+
+/**
+ * @brief         daemon sample
+ * @param[in,out] *state pointer to a daemon state structure
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          the anchor moves to the middle of the window in which the seconds changed,
+ *                a locked anchor only gives way to a window narrower than its aged error
+ */
+static uint8_t a_daemon_sample(daemon_state_t *state)
+{
+    time_t ts;
+    uint64_t t0;
+    uint64_t t1;
+    uint32_t error_ns;
+
+    /* read the chip */
+    t0 = ds1307_interface_get_tick_ns();
+    if (ds1307_basic_get_timestamp(&ts) != 0)
+    {
+        state->flags |= TIMEPAGE_FLAG_STALE;
+
+        return 1;
+    }
+    t1 = ds1307_interface_get_tick_ns();
+    state->flags &= ~TIMEPAGE_FLAG_STALE;
+
+    if ((state->flags & TIMEPAGE_FLAG_VALID) == 0)
+    {
+        /* first read, the phase is unknown */
+        state->epoch = (int64_t)ts;
+        state->anchor_ns = t1;
+        state->error_ns = 1000000000U;
+        state->flags |= TIMEPAGE_FLAG_VALID;
+        state->change_ns = t1;
+    }
+    else if ((int64_t)ts == state->second + 1)
+    {
+        /* the edge lies between the start of the last read and the end of this one */
+        error_ns = (uint32_t)((t1 - state->last_ns) / 2);
+        if (((state->flags & TIMEPAGE_FLAG_LOCKED) == 0) || (error_ns <= a_daemon_error(state, t1)))
+        {
+            state->epoch = (int64_t)ts;
+            state->anchor_ns = state->last_ns + error_ns;
+            state->error_ns = error_ns;
+            state->flags |= TIMEPAGE_FLAG_LOCKED;
+        }
+        state->flags &= ~TIMEPAGE_FLAG_HALTED;
+        state->change_ns = t1;
+    }
+    else if ((int64_t)ts != state->second)
+    {
+        /* the time jumped, lock again */
+        state->epoch = (int64_t)ts;
+        state->anchor_ns = t1;
+        state->error_ns = 1000000000U;
+        state->flags &= ~(TIMEPAGE_FLAG_LOCKED | TIMEPAGE_FLAG_HALTED);
+        state->change_ns = t1;
+    }
+    else if (t1 - state->change_ns > 2000000000ULL)
+    {
+        /* the oscillator stopped, hold the time still */
+        state->epoch = (int64_t)ts;
+        state->anchor_ns = t1;
+        state->error_ns = 1000000000U;
+        state->flags &= ~TIMEPAGE_FLAG_LOCKED;
+        state->flags |= TIMEPAGE_FLAG_HALTED;
+    }
+    else
+    {
+        /* same second */
+    }
+    state->second = (int64_t)ts;
+    state->last_ns = t0;
+
+    return 0;
+}
+
+/**
+ * @brief     daemon next sample delay
+ * @param[in] *state pointer to a daemon state structure
+ * @param[in] interval_ns poll interval in ns
+ * @return    delay in ns
+ * @note      once locked the daemon sleeps until shortly before the next expected edge
+ */
+static uint64_t a_daemon_delay(daemon_state_t *state, uint64_t interval_ns)
+{
+    uint64_t next;
+    uint64_t now;
+
+    if ((state->flags & TIMEPAGE_FLAG_LOCKED) == 0)
+    {
+        return interval_ns;
+    }
+    next = state->anchor_ns + 1000000000ULL * (uint64_t)(state->second - state->epoch + 1);
+    now = ds1307_interface_get_tick_ns();
+    if (next > now + 3 * interval_ns)
+    {
+        return next - now - 2 * interval_ns;
+    }
+
+    return interval_ns;
+}
+
+/**
+ * @brief         daemon command
+ * @param[in]     fd listening socket
+ * @param[in,out] *state pointer to a daemon state structure
+ * @note          one command line per connection, the reply is one line starting with ok or error
+ */
+static void a_daemon_command(int fd, daemon_state_t *state)
+{
+    int cfd;
+    struct timeval tv;
+    char line[160];
+    char reply[160];
+    uint8_t buf[56];
+    ssize_t n;
+    uint32_t pos;
+    long long epoch;
+    unsigned int addr;
+    unsigned int len;
+    unsigned int i;
+    char hex[120];
+
+    cfd = accept(fd, NULL, NULL);
+    if (cfd < 0)
+    {
+        return;
+    }
+
+    /* a stuck client must not stall the daemon */
+    tv.tv_sec = 0;
+    tv.tv_usec = 100000;
+    (void)setsockopt(cfd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    pos = 0;
+    while (pos < sizeof(line) - 1)
+    {
+        n = recv(cfd, line + pos, sizeof(line) - 1 - pos, 0);
+        if (n <= 0)
+        {
+            break;
+        }
+        pos += (uint32_t)n;
+        if (line[pos - 1] == '\n')
+        {
+            break;
+        }
+    }
+    line[pos] = 0;
+
+    /* run the command */
+    if (strncmp(line, "time", 4) == 0)
+    {
+        uint64_t elapsed;
+        uint64_t now;
+
+        now = ds1307_interface_get_tick_ns();
+        elapsed = (now > state->anchor_ns) ? (now - state->anchor_ns) : 0;
+        snprintf(reply, sizeof(reply), "ok %lld.%09u 0x%02X\n",
+                 (long long)(state->epoch + (int64_t)(elapsed / 1000000000ULL)),
+                 (unsigned int)(elapsed % 1000000000ULL), (unsigned int)state->flags);
+    }
+    else if (sscanf(line, "set-time %lld", &epoch) == 1)
+    {
+        if (ds1307_basic_set_timestamp((time_t)epoch) != 0)
+        {
+            snprintf(reply, sizeof(reply), "error failed\n");
+        }
+        else
+        {
+            /* lock again on the new time */
+            state->flags &= ~(TIMEPAGE_FLAG_VALID | TIMEPAGE_FLAG_LOCKED | TIMEPAGE_FLAG_HALTED);
+            snprintf(reply, sizeof(reply), "ok\n");
+        }
+    }
+    else if (sscanf(line, "read-ram %u %u", &addr, &len) == 2)
+    {
+        if ((addr > 55) || (len == 0) || (addr + len > 56))
+        {
+            snprintf(reply, sizeof(reply), "error invalid\n");
+        }
+        else if (ds1307_basic_read_ram((uint8_t)addr, buf, (uint8_t)len) != 0)
+        {
+            snprintf(reply, sizeof(reply), "error failed\n");
+        }
+        else
+        {
+            pos = (uint32_t)snprintf(reply, sizeof(reply), "ok ");
+            for (i = 0; i < len; i++)
+            {
+                pos += (uint32_t)snprintf(reply + pos, sizeof(reply) - pos, "%02X", buf[i]);
+            }
+            snprintf(reply + pos, sizeof(reply) - pos, "\n");
+        }
+    }
+    else if (sscanf(line, "write-ram %u %119[0-9a-fA-F]", &addr, hex) == 2)
+    {
+        len = (unsigned int)strlen(hex) / 2;
+        if (((strlen(hex) % 2) != 0) || (addr > 55) || (len == 0) || (addr + len > 56))
+        {
+            snprintf(reply, sizeof(reply), "error invalid\n");
+        }
+        else
+        {
+            for (i = 0; i < len; i++)
+            {
+                unsigned int value;
+
+                (void)sscanf(&hex[i * 2], "%2x", &value);
+                buf[i] = (uint8_t)value;
+            }
+            if (ds1307_basic_write_ram((uint8_t)addr, buf, (uint8_t)len) != 0)
+            {
+                snprintf(reply, sizeof(reply), "error failed\n");
+            }
+            else
+            {
+                snprintf(reply, sizeof(reply), "ok\n");
+            }
+        }
+    }
+    else
+    {
+        snprintf(reply, sizeof(reply), "error invalid\n");
+    }
+    (void)send(cfd, reply, strlen(reply), MSG_NOSIGNAL);
+    (void)close(cfd);
+}
+
+/**
+ * @brief     ds1307 daemon
+ * @param[in] *shm pointer to a shared memory name buffer
+ * @param[in] *path pointer to a control socket path buffer
+ * @param[in] interval poll interval in ms
+ * @param[in] times update number, 0 means until SIGINT or SIGTERM
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      owns the chip, publishes the time into the shared page and serves the control socket
+ */
+static uint8_t a_ds1307_daemon(const char *shm, const char *path, uint32_t interval, uint32_t times)
+{
+    int fd;
+    struct sockaddr_un addr;
+    struct sigaction sa;
+    struct pollfd pfd;
+    daemon_state_t state;
+    uint64_t deadline;
+    uint64_t now;
+    uint32_t count;
+
+    /* basic init */
+    if (ds1307_basic_init() != 0)
+    {
+        return 1;
+    }
+    if (ds1307_basic_set_timestamp_time_zone(0) != 0)
+    {
+        (void)ds1307_basic_deinit();
+
+        return 1;
+    }
+
+    /* create the page */
+    if (timepage_create(shm) != 0)
+    {
+        (void)ds1307_basic_deinit();
+
+        return 1;
+    }
+
+    /* open the control socket */
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+    {
+        (void)timepage_destroy();
+        (void)ds1307_basic_deinit();
+
+        return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    (void)unlink(path);
+    if ((bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) || (listen(fd, 8) != 0))
+    {
+        perror("ds1307: bind failed.\n");
+        (void)close(fd);
+        (void)timepage_destroy();
+        (void)ds1307_basic_deinit();
+
+        return 1;
+    }
+
+    /* stop on SIGINT and SIGTERM */
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = a_daemon_signal;
+    (void)sigaction(SIGINT, &sa, NULL);
+    (void)sigaction(SIGTERM, &sa, NULL);
+    ds1307_interface_debug_print("ds1307: daemon publishes %s, control on %s.\n", shm, path);
+
+    /* serve */
+    memset(&state, 0, sizeof(state));
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    deadline = 0;
+    count = 0;
+    while ((gs_daemon_stop == 0) && ((times == 0) || (count < times)))
+    {
+        now = ds1307_interface_get_tick_ns();
+        if (now >= deadline)
+        {
+            (void)a_daemon_sample(&state);
+            (void)timepage_publish(state.epoch, state.anchor_ns,
+                                   a_daemon_error(&state, ds1307_interface_get_tick_ns()), state.flags);
+            count++;
+            deadline = ds1307_interface_get_tick_ns() + a_daemon_delay(&state, 1000000ULL * interval);
+
+            continue;
+        }
+        if (poll(&pfd, 1, (int)((deadline - now + 999999ULL) / 1000000ULL)) > 0)
+        {
+            a_daemon_command(fd, &state);
+            if ((state.flags & TIMEPAGE_FLAG_VALID) == 0)
+            {
+                /* the time was set, read it back at once */
+                deadline = 0;
+            }
+        }
+    }
+    ds1307_interface_debug_print("ds1307: daemon stopped after %d updates.\n", count);
+
+    /* close all */
+    (void)close(fd);
+    (void)unlink(path);
+    (void)timepage_destroy();
+    (void)ds1307_basic_deinit();
+
+    return 0;
+}
+
+/**
+ * @brief     ds1307 daemon test
+ * @param[in] interval poll interval in ms
+ * @param[in] times test minutes
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs the daemon sampling on the virtual clock of the emulator against a chip
+ *            that runs DAEMON_TEST_SKEW_PPM fast, the extrapolated time must stay within the published error
+ */
+static uint8_t a_daemon_test(uint32_t interval, uint32_t times)
+{
+    daemon_state_t state;
+    time_t ts;
+    uint64_t start;
+    uint64_t now;
+    uint64_t step;
+    uint64_t chain;
+    int64_t diff;
+    uint64_t last_anchor;
+    uint32_t seed;
+    uint32_t anchor;
+    uint32_t error_ns;
+
+    /* start daemon test */
+    ds1307_interface_debug_print("ds1307: start daemon test.\n");
+
+    /* the test runs on the virtual clock */
+    if ((ds1307_emulator_get_attach() == 0) ||
+        (ds1307_emulator_get_clock() != DS1307_EMULATOR_CLOCK_VIRTUAL))
+    {
+        ds1307_interface_debug_print("ds1307: daemon test needs the emulator.\n");
+
+        return 1;
+    }
+
+    /* basic init */
+    if (ds1307_basic_init() != 0)
+    {
+        return 1;
+    }
+    if (ds1307_basic_set_timestamp_time_zone(0) != 0)
+    {
+        (void)ds1307_basic_deinit();
+
+        return 1;
+    }
+
+    /* the chain starts at the write of the seconds */
+    ts = 1700000000;
+    if (ds1307_basic_set_timestamp(ts) != 0)
+    {
+        (void)ds1307_basic_deinit();
+
+        return 1;
+    }
+    start = ds1307_interface_get_tick_ns();
+    (void)ds1307_emulator_set_skew(DAEMON_TEST_SKEW_PPM);
+    ds1307_interface_debug_print("ds1307: chip skew %d ppm.\n", DAEMON_TEST_SKEW_PPM);
+
+    /* sample with a jittered poll */
+    memset(&state, 0, sizeof(state));
+    seed = 1;
+    anchor = 0;
+    last_anchor = 0;
+    now = start;
+    while (now - start < 60000000000ULL * times)
+    {
+        seed = seed * 1103515245U + 12345U;
+        step = a_daemon_delay(&state, 1000000ULL * interval) + (seed >> 8) % (1000000ULL * interval);
+        (void)ds1307_emulator_advance(step);
+        if (a_daemon_sample(&state) != 0)
+        {
+            ds1307_interface_debug_print("ds1307: sample failed.\n");
+            (void)ds1307_emulator_set_skew(0);
+            (void)ds1307_basic_deinit();
+
+            return 1;
+        }
+        now = ds1307_interface_get_tick_ns();
+        if ((state.flags & TIMEPAGE_FLAG_LOCKED) == 0)
+        {
+            continue;
+        }
+        if (state.anchor_ns != last_anchor)
+        {
+            last_anchor = state.anchor_ns;
+            anchor++;
+        }
+
+        /* the chip time against the extrapolated time */
+        chain = (now - start) + (now - start) / 1000000ULL * DAEMON_TEST_SKEW_PPM;
+        diff = (state.epoch - (int64_t)ts) * 1000000000LL + (int64_t)(now - state.anchor_ns) - (int64_t)chain;
+        error_ns = a_daemon_error(&state, now);
+        if ((diff > (int64_t)error_ns) || (-diff > (int64_t)error_ns))
+        {
+            ds1307_interface_debug_print("ds1307: time off by %lld ns, error is %u ns.\n", (long long)diff, error_ns);
+            ds1307_interface_debug_print("ds1307: check anchor error error.\n");
+            (void)ds1307_emulator_set_skew(0);
+            (void)ds1307_basic_deinit();
+
+            return 1;
+        }
+    }
+    ds1307_interface_debug_print("ds1307: %u anchors in %u minutes.\n", anchor, times);
+    ds1307_interface_debug_print("ds1307: check anchor error ok.\n");
+
+    /* finish daemon test */
+    (void)ds1307_emulator_set_skew(0);
+    (void)ds1307_basic_deinit();
+    ds1307_interface_debug_print("ds1307: finish daemon test.\n");
+
+    return 0;
+}
 
 /**
  * @brief     ds1307 full function
@@ -57,7 +590,7 @@ uint8_t ds1307(uint8_t argc, char **argv)
 {
     int c;
     int longindex = 0;
-    const char short_options[] = "hipe:t:";
+    const char short_options[] = "hipe:t:dc:";
     const struct option long_options[] =
     {
         {"help", no_argument, NULL, 'h'},
@@ -72,11 +605,19 @@ uint8_t ds1307(uint8_t argc, char **argv)
         {"level", required_argument, NULL, 5},
         {"times", required_argument, NULL, 6},
         {"timestamp", required_argument, NULL, 7},
+        {"emulator", no_argument, NULL, 8},
+        {"trace", required_argument, NULL, 9},
+        {"daemon", no_argument, NULL, 'd'},
+        {"control", required_argument, NULL, 'c'},
+        {"shm", required_argument, NULL, 10},
+        {"socket", required_argument, NULL, 11},
+        {"interval", required_argument, NULL, 12},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     char mode_name[32] = {0};
     uint32_t times = 3;
+    uint8_t times_flag = 0;
     uint32_t t = 0;
     uint8_t time_flag = 0;
     uint8_t addr = 0x00;
@@ -89,6 +630,11 @@ uint8_t ds1307(uint8_t argc, char **argv)
     uint8_t mode_flag = 0x00;
     ds1307_output_level_t level = DS1307_OUTPUT_LEVEL_LOW;
     uint8_t level_flag = 0x00;
+    uint8_t emulator_flag = 0x00;
+    char shm[64] = TIMEPAGE_NAME;
+    char path[108] = TIMEPAGE_SOCKET;
+    char control[128] = {0};
+    uint32_t interval = 10;
 
     /* if no params */
     if (argc == 1)
@@ -159,6 +705,29 @@ uint8_t ds1307(uint8_t argc, char **argv)
                 break;
             }
 
+            /* daemon */
+            case 'd' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "d");
+
+                break;
+            }
+
+            /* control */
+            case 'c' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "c");
+
+                /* set the command */
+                snprintf(control, sizeof(control), "%s", optarg);
+
+                break;
+            }
+
             /* address */
             case 1 :
             {
@@ -316,6 +885,7 @@ uint8_t ds1307(uint8_t argc, char **argv)
             {
                 /* set the times */
                 times = atol(optarg);
+                times_flag = 1;
 
                 break;
             }
@@ -330,6 +900,58 @@ uint8_t ds1307(uint8_t argc, char **argv)
                 break;
             }
 
+            /* emulator */
+            case 8 :
+            {
+                /* run against the emulator */
+                emulator_flag = 1;
+
+                break;
+            }
+
+            /* trace */
+            case 9 :
+            {
+                /* open the trace file */
+                if (trace_init(optarg) != 0)
+                {
+                    return 1;
+                }
+
+                break;
+            }
+
+            /* shared memory name */
+            case 10 :
+            {
+                /* set the name */
+                snprintf(shm, sizeof(shm), "%s", optarg);
+
+                break;
+            }
+
+            /* control socket path */
+            case 11 :
+            {
+                /* set the path */
+                snprintf(path, sizeof(path), "%s", optarg);
+
+                break;
+            }
+
+            /* poll interval */
+            case 12 :
+            {
+                /* set the interval */
+                interval = atol(optarg);
+                if (interval == 0)
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
             /* the end */
             case -1 :
             {
@@ -344,6 +966,13 @@ uint8_t ds1307(uint8_t argc, char **argv)
         }
     } while (c != -1);
 
+    /* attach the emulator */
+    if (emulator_flag != 0)
+    {
+        (void)ds1307_emulator_reset();
+        (void)ds1307_emulator_set_attach(DS1307_BOOL_TRUE);
+    }
+
     /* run the function */
     if (strcmp("t_reg", type) == 0)
     {
@@ -381,6 +1010,69 @@ uint8_t ds1307(uint8_t argc, char **argv)
             return 0;
         }
     }
+    else if (strcmp("t_sqw", type) == 0)
+    {
+        uint8_t res;
+
+        /* the emulator raises the edges itself */
+        if (emulator_flag != 0)
+        {
+            (void)ds1307_emulator_set_sqw_callback(ds1307_sqw_test_irq_handler);
+            res = ds1307_sqw_test(times);
+            (void)ds1307_emulator_set_sqw_callback(NULL);
+
+            return (res != 0) ? 1 : 0;
+        }
+
+        /* gpio init */
+        g_gpio_irq = ds1307_sqw_test_irq_handler;
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            g_gpio_irq = NULL;
+
+            return 1;
+        }
+
+        /* run sqw test */
+        res = ds1307_sqw_test(times);
+
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq = NULL;
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_async", type) == 0)
+    {
+        /* run async test */
+        if (ds1307_async_test() != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_daemon", type) == 0)
+    {
+        /* run daemon test */
+        if (a_daemon_test(interval, times) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("e_basic-set-time", type) == 0)
     {
         uint8_t res;
@@ -813,6 +1505,51 @@ uint8_t ds1307(uint8_t argc, char **argv)
 
         return 0;
     }
+    else if (strcmp("e_bench", type) == 0)
+    {
+        /* run bench */
+        if (ds1307_bench((times_flag != 0) ? times : 10000) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("d", type) == 0)
+    {
+        /* the emulated chip follows the real clock of the clients */
+        if (emulator_flag != 0)
+        {
+            (void)ds1307_emulator_set_clock(DS1307_EMULATOR_CLOCK_REAL);
+        }
+
+        /* run the daemon */
+        if (a_ds1307_daemon(shm, path, interval, (times_flag != 0) ? times : 0) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("c", type) == 0)
+    {
+        char reply[160];
+
+        /* send the command */
+        if (timepage_control(path, control, reply, sizeof(reply)) != 0)
+        {
+            return 1;
+        }
+
+        /* output */
+        ds1307_interface_debug_print("ds1307: %s.\n", reply);
+
+        return (strncmp(reply, "ok", 2) == 0) ? 0 : 1;
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
@@ -820,41 +1557,56 @@ uint8_t ds1307(uint8_t argc, char **argv)
         ds1307_interface_debug_print("  ds1307 (-i | --information)\n");
         ds1307_interface_debug_print("  ds1307 (-h | --help)\n");
         ds1307_interface_debug_print("  ds1307 (-p | --port)\n");
-        ds1307_interface_debug_print("  ds1307 (-t reg | --test=reg)\n");
-        ds1307_interface_debug_print("  ds1307 (-t ram | --test=ram) [--times=<num>]\n");
-        ds1307_interface_debug_print("  ds1307 (-t output | --test=output) [--times=<num>]\n");
-        ds1307_interface_debug_print("  ds1307 (-e basic-set-time | --example=basic-set-time) --timestamp=<time>\n");
-        ds1307_interface_debug_print("  ds1307 (-e basic-get-time | --example=basic-get-time)\n");
-        ds1307_interface_debug_print("  ds1307 (-e basic-set-ram | --example=basic-set-ram) --addr=<address> --data=<hex>\n");
-        ds1307_interface_debug_print("  ds1307 (-e basic-get-ram | --example=basic-get-ram) --addr=<address>\n");
-        ds1307_interface_debug_print("  ds1307 (-e output-set-time | --example=output-set-time) --timestamp=<time>\n");
-        ds1307_interface_debug_print("  ds1307 (-e output-get-time | --example=output-get-time)\n");
-        ds1307_interface_debug_print("  ds1307 (-e output-set-mode | --example=output-set-mode) --mode=<LEVEL | SQUARE_WAVE>\n");
-        ds1307_interface_debug_print("  ds1307 (-e output-get-mode | --example=output-get-mode)\n");
-        ds1307_interface_debug_print("  ds1307 (-e output-set-level | --example=output-set-level) --level=<LOW | HIGH>\n");
-        ds1307_interface_debug_print("  ds1307 (-e output-get-level | --example=output-get-level)\n");
-        ds1307_interface_debug_print("  ds1307 (-e output-set-freq | --example=output-set-freq) --freq=<1HZ | 4096HZ | 8192HZ | 32768HZ>\n");
-        ds1307_interface_debug_print("  ds1307 (-e output-get-freq | --example=output-get-freq)\n");
+        ds1307_interface_debug_print("  ds1307 (-t reg | --test=reg) [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-t ram | --test=ram) [--times=<num>] [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-t output | --test=output) [--times=<num>] [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-t sqw | --test=sqw) [--times=<num>] [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-t async | --test=async) [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-t daemon | --test=daemon) [--interval=<ms>] [--times=<num>] --emulator [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e basic-set-time | --example=basic-set-time) --timestamp=<time> [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e basic-get-time | --example=basic-get-time) [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e basic-set-ram | --example=basic-set-ram) --addr=<address> --data=<hex> [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e basic-get-ram | --example=basic-get-ram) --addr=<address> [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e output-set-time | --example=output-set-time) --timestamp=<time> [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e output-get-time | --example=output-get-time) [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e output-set-mode | --example=output-set-mode) --mode=<LEVEL | SQUARE_WAVE> [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e output-get-mode | --example=output-get-mode) [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e output-set-level | --example=output-set-level) --level=<LOW | HIGH> [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e output-get-level | --example=output-get-level) [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e output-set-freq | --example=output-set-freq) --freq=<1HZ | 4096HZ | 8192HZ | 32768HZ> [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e output-get-freq | --example=output-get-freq) [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-e bench | --example=bench) [--times=<num>]\n");
+        ds1307_interface_debug_print("  ds1307 (-d | --daemon) [--shm=<name>] [--socket=<path>] [--interval=<ms>] [--times=<num>] [--emulator] [--trace=<file>]\n");
+        ds1307_interface_debug_print("  ds1307 (-c <command> | --control=<command>) [--socket=<path>]\n");
         ds1307_interface_debug_print("\n");
         ds1307_interface_debug_print("Options:\n");
         ds1307_interface_debug_print("      --addr=<address>            Set ram address.([default: 0])\n");
+        ds1307_interface_debug_print("  -c <time | set-time <epoch> | read-ram <addr> <len> | write-ram <addr> <hex>>,\n");
+        ds1307_interface_debug_print("      --control=<time | set-time <epoch> | read-ram <addr> <len> | write-ram <addr> <hex>>\n");
+        ds1307_interface_debug_print("                                  Send a command to the running daemon.\n");
+        ds1307_interface_debug_print("  -d, --daemon                    Own the chip and publish the time into a shared memory page.\n");
         ds1307_interface_debug_print("      --data=<hex>                Set ram data and it is hexadecimal.([default: 0x00])\n");
+        ds1307_interface_debug_print("      --emulator                  Run against the in-process emulator instead of the chip.\n");
         ds1307_interface_debug_print("  -e <basic-set-time | basic-get-time | basic-set-ram | basic-get-ram | output-set-time | output-get-time |\n");
         ds1307_interface_debug_print("      output-set-mode | output-get-mode | output-set-level | output-get-level |\n");
-        ds1307_interface_debug_print("      output-set-freq | output-get-freq>\n");
+        ds1307_interface_debug_print("      output-set-freq | output-get-freq | bench>\n");
         ds1307_interface_debug_print("                                  Run the driver example.\n");
         ds1307_interface_debug_print("      --freq=<1HZ | 4096HZ | 8192HZ | 32768HZ>\n");
         ds1307_interface_debug_print("                                  Set output frequency.([default: 1HZ])\n");
         ds1307_interface_debug_print("  -h, --help                      Show the help.\n");
         ds1307_interface_debug_print("  -i, --information               Show the chip information.\n");
+        ds1307_interface_debug_print("      --interval=<ms>             Set the daemon poll interval.([default: 10])\n");
         ds1307_interface_debug_print("      --mode=<LEVEL | SQUARE_WAVE>\n");
         ds1307_interface_debug_print("                                  Set the output mode.([default: LEVEL])\n");
         ds1307_interface_debug_print("      --level=<LOW | HIGH>        Set output level.([default: LOW])\n");
         ds1307_interface_debug_print("  -p, --port                      Display the pin connections of the current board.\n");
-        ds1307_interface_debug_print("  -t <reg | ram | output>, --test=<reg | ram | output>\n");
+        ds1307_interface_debug_print("      --shm=<name>                Set the shared memory name.([default: /ds1307])\n");
+        ds1307_interface_debug_print("      --socket=<path>             Set the control socket path.([default: /run/ds1307.sock])\n");
+        ds1307_interface_debug_print("  -t <reg | ram | output | sqw | async | daemon>, --test=<reg | ram | output | sqw | async | daemon>\n");
         ds1307_interface_debug_print("                                  Run the driver test.\n");
         ds1307_interface_debug_print("      --times=<num>               Set the running times.([default: 3])\n");
         ds1307_interface_debug_print("      --timestamp=<time>          Set the the unix timestamp.\n");
+        ds1307_interface_debug_print("      --trace=<file>              Write every bus transfer to a chrome trace json file.\n");
 
         return 0;
     }
@@ -881,6 +1633,7 @@ uint8_t ds1307(uint8_t argc, char **argv)
         /* print pin connection */
         ds1307_interface_debug_print("ds1307: SCL connected to GPIO3(BCM).\n");
         ds1307_interface_debug_print("ds1307: SDA connected to GPIO2(BCM).\n");
+        ds1307_interface_debug_print("ds1307: SQW/OUT connected to GPIO17(BCM).\n");
 
         return 0;
     }
@@ -903,6 +1656,7 @@ int main(uint8_t argc, char **argv)
     uint8_t res;
 
     res = ds1307(argc, argv);
+    (void)trace_deinit();
     if (res == 0)
     {
         /* run success */
@@ -96,6 +96,163 @@ uint8_t ds1307_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return iic_write(addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus init with a context
+ * @param[in] *user pointer to a ds1307 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      the board has one iic bus, the context is unused
+ */
+uint8_t ds1307_interface_iic_init_ctx(void *user)
+{
+    (void)user;
+    
+    return ds1307_interface_iic_init();
+}
+
+/**
+ * @brief     interface iic bus deinit with a context
+ * @param[in] *user pointer to a ds1307 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t ds1307_interface_iic_deinit_ctx(void *user)
+{
+    (void)user;
+    
+    return ds1307_interface_iic_deinit();
+}
+
+/**
+ * @brief      interface iic bus read with a context
+ * @param[in]  *user pointer to a ds1307 interface context structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ds1307_interface_iic_read_ctx(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)user;
+    
+    return ds1307_interface_iic_read(addr, reg, buf, len);
+}
+
+/**
+ * @brief     interface iic bus write with a context
+ * @param[in] *user pointer to a ds1307 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ds1307_interface_iic_write_ctx(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)user;
+    
+    return ds1307_interface_iic_write(addr, reg, buf, len);
+}
+
+/**
+ * @brief      interface iic bus read without blocking
+ * @param[in]  *user pointer to a ds1307 interface context structure or NULL
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[in]  *token completion token, passed back to ds1307_async_complete
+ * @return     status code
+ *             - 0 success
+ *             - 1 read start failed
+ * @note       the board has no iic dma path, the transfer runs and completes before it returns
+ */
+uint8_t ds1307_interface_iic_read_async(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *token)
+{
+    uint8_t res;
+    
+    (void)user;
+    res = ds1307_interface_iic_read(addr, reg, buf, len);
+    (void)ds1307_async_complete((ds1307_handle_t *)token, res);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus write without blocking
+ * @param[in] *user pointer to a ds1307 interface context structure or NULL
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @param[in] *token completion token, passed back to ds1307_async_complete
+ * @return    status code
+ *            - 0 success
+ *            - 1 write start failed
+ * @note      the board has no iic dma path, the transfer runs and completes before it returns
+ */
+uint8_t ds1307_interface_iic_write_async(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len, void *token)
+{
+    uint8_t res;
+    
+    (void)user;
+    res = ds1307_interface_iic_write(addr, reg, buf, len);
+    (void)ds1307_async_complete((ds1307_handle_t *)token, res);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus transfer of several messages
+ * @param[in] *user pointer to a ds1307 interface context structure or NULL
+ * @param[in] *msg pointer to a message array
+ * @param[in] len message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the board has no vectored iic transfer, the messages run one by one
+ */
+uint8_t ds1307_interface_iic_transfer(void *user, ds1307_iic_msg_t *msg, uint8_t len)
+{
+    uint8_t i;
+    
+    (void)user;
+    for (i = 0; i < len; i++)
+    {
+        if ((msg[i].flags == DS1307_IIC_MSG_WRITE) && (i + 1 < len) && (msg[i + 1].flags == DS1307_IIC_MSG_READ))
+        {
+            if (ds1307_interface_iic_read(msg[i].addr, msg[i].buf[0], msg[i + 1].buf, msg[i + 1].len) != 0)
+            {
+                return 1;
+            }
+            i++;
+        }
+        else if (msg[i].flags == DS1307_IIC_MSG_WRITE)
+        {
+            if (ds1307_interface_iic_write(msg[i].addr, msg[i].buf[0], &msg[i].buf[1], (uint16_t)(msg[i].len - 1)) != 0)
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -106,6 +263,49 @@ void ds1307_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief  interface get tick ns
+ * @return monotonic tick in ns
+ * @note   only needed by the time cache
+ */
+uint64_t ds1307_interface_get_tick_ns(void)
+{
+    return (uint64_t)HAL_GetTick() * 1000000ULL;
+}
+
+/**
+ * @brief  interface stats tick
+ * @return dwt cycle counter
+ * @note   only needed by the stats latency histograms, the counter is started on the first call
+ */
+uint32_t ds1307_interface_stats_tick(void)
+{
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    
+    return DWT->CYCCNT;
+}
+
+#if (DS1307_CONFIG_TRACE != 0)
+/**
+ * @brief     interface trace
+ * @param[in] *user pointer to a ds1307 interface context structure or NULL
+ * @param[in] *event pointer to a trace event structure
+ * @note      one line per transfer on the uart, times are in ms as get_tick_ns follows HAL_GetTick
+ */
+void ds1307_interface_trace(void *user, ds1307_trace_t *event)
+{
+    (void)user;
+    ds1307_interface_debug_print("trace: %s %s reg 0x%02X len %d res %d at %dms for %dms.\n",
+                                 event->api, (event->read != 0) ? "read" : "write", event->reg, event->len, event->res,
+                                 (uint32_t)(event->start_ns / 1000000ULL), (uint32_t)((event->end_ns - event->lock_ns) / 1000000ULL));
+}
+#endif
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
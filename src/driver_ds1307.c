@@ -35,6 +35,9 @@
  */
 
 #include "driver_ds1307.h"
+#if (DS1307_CONFIG_USDT != 0)
+#include <sys/sdt.h>
+#endif
 
 /**
  * @brief chip information definition
@@ -66,9 +69,595 @@
  */
 #define DS1307_ADDRESS        0xD0        /**< iic device address */ 
 
+/**
+ * @brief control register bit definition
+ */
+#define DS1307_CONTROL_MASK             0x93        /**< out, sqwe and rs bits */
+
+/**
+ * @brief register cache valid flag definition
+ */
+#define DS1307_REG_CACHE_CONTROL        (1 << 0)        /**< control register is cached */
+#define DS1307_REG_CACHE_CH             (1 << 1)        /**< clock halt bit is cached */
+
+/**
+ * @brief time cache default interval definition
+ */
+#define DS1307_TIME_CACHE_DEFAULT_INTERVAL_MS        1000        /**< 1s */
+
+/**
+ * @brief epoch range definition
+ */
+#define DS1307_EPOCH_2000                     946684800UL          /**< unix time of 2000-01-01 00:00:00 */
+#define DS1307_EPOCH_2100                     4102444800UL         /**< unix time of 2100-01-01 00:00:00 */
+
+/**
+ * @brief ram cache gap definition
+ * @note  a new burst costs a start, the address and the register byte,
+ *        so clean gaps up to 2 bytes are cheaper to rewrite
+ */
+#define DS1307_RAM_CACHE_GAP            2        /**< max clean bytes merged into a burst */
+
+/**
+ * @brief async operation definition
+ */
+#define DS1307_ASYNC_IDLE               0        /**< no operation */
+#define DS1307_ASYNC_READ               1        /**< read registers */
+#define DS1307_ASYNC_WRITE              2        /**< write registers */
+#define DS1307_ASYNC_UPDATE             3        /**< read, modify and write one register */
+#define DS1307_ASYNC_GET_TIME           4        /**< read the time registers */
+#define DS1307_ASYNC_SET_TIME           5        /**< keep ch and write the time registers */
+
+/**
+ * @brief transaction operation definition
+ */
+#define DS1307_TRANSACTION_RAW          0        /**< nothing to decode */
+#define DS1307_TRANSACTION_TIME         1        /**< decode a time */
+#define DS1307_TRANSACTION_CONTROL      2        /**< decode an output config */
+
+/**
+ * @brief memory barrier definition
+ * @note  orders the seqlock sequences and the async busy flag against their data across cores
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define DS1307_MEMORY_BARRIER()        __sync_synchronize()        /**< full barrier */
+#else
+#define DS1307_MEMORY_BARRIER()                                     /**< single core targets */
+#endif
+
+/**
+ * @brief atomic fetch and increment definition
+ * @note  claims log ring entries without a lock
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define DS1307_ATOMIC_FETCH_INC(PTR)        __sync_fetch_and_add(PTR, 1)        /**< atomic add */
+#else
+#define DS1307_ATOMIC_FETCH_INC(PTR)        (*(PTR))++                          /**< single core targets */
+#endif
+
+/**
+ * @brief stats hook definition
+ * @note  the hooks expand to nothing when the stats are compiled out
+ */
+#if (DS1307_CONFIG_STATS != 0)
+#define DS1307_STATS_OP(OP)                                        (uint8_t)(OP)
+#define DS1307_STATS_START(HANDLE)                                 a_ds1307_stats_start(HANDLE)
+#define DS1307_STATS_COUNT(HANDLE, OP, IN, OUT)                    a_ds1307_stats_count(HANDLE, OP, IN, OUT)
+#define DS1307_STATS_LATENCY(HANDLE, OP, RES, START)               a_ds1307_stats_latency(HANDLE, OP, RES, START)
+#define DS1307_STATS_RETRY(HANDLE, OP)                             (HANDLE)->stats.op[OP].retry++
+#define DS1307_STATS_ASYNC_START(HANDLE)                           (HANDLE)->stats_async_tick = a_ds1307_stats_start(HANDLE)
+#define DS1307_STATS_ASYNC_LATENCY(HANDLE, RES)                    a_ds1307_stats_latency(HANDLE, DS1307_STATS_OP_ASYNC, RES, \
+                                                                                          (HANDLE)->stats_async_tick)
+#else
+#define DS1307_STATS_OP(OP)                                        0
+#define DS1307_STATS_START(HANDLE)                                 0
+#define DS1307_STATS_COUNT(HANDLE, OP, IN, OUT)
+#define DS1307_STATS_LATENCY(HANDLE, OP, RES, START)               (void)(START)
+#define DS1307_STATS_RETRY(HANDLE, OP)
+#define DS1307_STATS_ASYNC_START(HANDLE)
+#define DS1307_STATS_ASYNC_LATENCY(HANDLE, RES)
+#endif
+
+/**
+ * @brief trace hook definition
+ * @note  the hooks expand to nothing when the trace is compiled out
+ */
+#if (DS1307_CONFIG_TRACE != 0)
+#define DS1307_TRACE_API()                                              __func__
+#define DS1307_TRACE_TICK(HANDLE)                                       a_ds1307_trace_tick(HANDLE)
+#define DS1307_TRACE(HANDLE, API, READ, REG, LEN, LOCK, START, RES)     a_ds1307_trace(HANDLE, API, READ, REG, LEN, LOCK, START, RES)
+#else
+#define DS1307_TRACE_API()                                              NULL
+#define DS1307_TRACE_TICK(HANDLE)                                       0
+#define DS1307_TRACE(HANDLE, API, READ, REG, LEN, LOCK, START, RES)     (void)(API), (void)(LOCK), (void)(START)
+#endif
+
+/**
+ * @brief usdt probe definition
+ * @note  every probe is a single nop until a tracer attaches, the return probe fires when the api scope is left
+ */
+#if (DS1307_CONFIG_USDT != 0)
+#define DS1307_PROBE_ENTER(CTX)                                    const char *probe_api __attribute__((cleanup(a_ds1307_probe_return))) = __func__; \
+                                                                   DTRACE_PROBE2(ds1307, api_entry, probe_api, (void *)(CTX))
+#else
+#define DS1307_PROBE_ENTER(CTX)
+#endif
+
+/**
+ * @brief api context structure definition
+ * @note  lives on the stack of the public api, so concurrent calls on one handle never share it
+ */
+typedef struct ds1307_api_s
+{
+    uint8_t op;              /**< operation the bus transfers are counted to */
+    const char *name;        /**< public api the bus transfers are traced to */
+} ds1307_api_t;
+
+/**
+ * @brief api entry definition
+ * @note  declares the context the following bus transfers are passed
+ */
+#define DS1307_API_ENTER(OP)                                       const ds1307_api_t api = {DS1307_STATS_OP(OP), DS1307_TRACE_API()}
+
+/**
+ * @brief sqw timeout definition
+ */
+#define DS1307_SQW_TIMEOUT_NS                 1500000000ULL        /**< 1.5s without an edge drops the sqw lock */
+
+/**
+ * @brief time check error bit definition
+ */
+#define DS1307_TIME_ERROR_YEAR          (1 << 0)        /**< year is invalid */
+#define DS1307_TIME_ERROR_MONTH         (1 << 1)        /**< month is invalid */
+#define DS1307_TIME_ERROR_WEEK          (1 << 2)        /**< week is invalid */
+#define DS1307_TIME_ERROR_DATE          (1 << 3)        /**< date is invalid */
+#define DS1307_TIME_ERROR_HOUR          (1 << 4)        /**< hour is invalid */
+#define DS1307_TIME_ERROR_MINUTE        (1 << 5)        /**< minute is invalid */
+#define DS1307_TIME_ERROR_SECOND        (1 << 6)        /**< second is invalid */
+#define DS1307_TIME_ERROR_FORMAT        (1 << 7)        /**< format is invalid */
+
+/**
+ * @brief bcd table row definition
+ */
+#define DS1307_BCD_ROW(T)        (T << 4) | 0, (T << 4) | 1, (T << 4) | 2, (T << 4) | 3, (T << 4) | 4, \
+                                 (T << 4) | 5, (T << 4) | 6, (T << 4) | 7, (T << 4) | 8, (T << 4) | 9
+
+/**
+ * @brief hex to bcd table
+ */
+static const uint8_t gs_hex2bcd[100] =
+{
+    DS1307_BCD_ROW(0), DS1307_BCD_ROW(1), DS1307_BCD_ROW(2), DS1307_BCD_ROW(3), DS1307_BCD_ROW(4),
+    DS1307_BCD_ROW(5), DS1307_BCD_ROW(6), DS1307_BCD_ROW(7), DS1307_BCD_ROW(8), DS1307_BCD_ROW(9),
+};
+
+/**
+ * @brief raw time field mask, indexed by the register
+ */
+static const uint8_t gs_raw_field_mask[7] = {0x7F, 0x7F, 0x3F, 0x07, 0x3F, 0x1F, 0xFF};
+
+/**
+ * @brief days before each month in a common year
+ */
+static const uint16_t gs_days_before_month[12] =
+{
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334,
+};
+
+/**
+ * @brief days of each month in a common year, index 0 rejects an invalid month
+ */
+static const uint8_t gs_days_in_month[13] =
+{
+    0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31,
+};
+
+/**
+ * @brief hour range indexed by the hour format
+ */
+static const uint8_t gs_hour_min[2] = {0, 1};         /**< 24H 0 - 23, 12H 1 - 12 */
+static const uint8_t gs_hour_span[2] = {23, 11};      /**< 24H 0 - 23, 12H 1 - 12 */
+
+#if (DS1307_CONFIG_LOG_TEXT != 0)
+/**
+ * @brief log message table indexed by the message id
+ */
+static const char *const gs_log_text[DS1307_LOG_MAX] =
+{
+    NULL,
+    "ds1307: iic_init is null.\n",
+    "ds1307: iic_deinit is null.\n",
+    "ds1307: iic_write is null.\n",
+    "ds1307: iic_read is null.\n",
+    "ds1307: delay_ms is null.\n",
+    "ds1307: get_tick_ns is null.\n",
+    "ds1307: iic init failed.\n",
+    "ds1307: iic deinit failed.\n",
+    "ds1307: year can't be over 2099 or less than 2000.\n",
+    "ds1307: month can't be zero or over than 12.\n",
+    "ds1307: week can't be zero or over than 7.\n",
+    "ds1307: date can't be zero or over the days of the month.\n",
+    "ds1307: hour can't be over than 23 in 24H or out of 1 - 12 in 12H.\n",
+    "ds1307: minute can't be over than 59.\n",
+    "ds1307: second can't be over than 59.\n",
+    "ds1307: format is invalid.\n",
+    "ds1307: time is null.\n",
+    "ds1307: time is invalid.\n",
+    "ds1307: epoch is null.\n",
+    "ds1307: epoch is invalid.\n",
+    "ds1307: second is null.\n",
+    "ds1307: raw is null.\n",
+    "ds1307: config is null.\n",
+    "ds1307: profile is null.\n",
+    "ds1307: profile is invalid.\n",
+    "ds1307: policy is invalid.\n",
+    "ds1307: stats is null.\n",
+    "ds1307: snapshot is null.\n",
+    "ds1307: buf is null.\n",
+    "ds1307: addr > 55.\n",
+    "ds1307: len is invalid.\n",
+    "ds1307: tr is null.\n",
+    "ds1307: read second failed.\n",
+    "ds1307: write second failed.\n",
+    "ds1307: write time failed.\n",
+    "ds1307: multiple read failed.\n",
+    "ds1307: read control failed.\n",
+    "ds1307: write control failed.\n",
+    "ds1307: set output config failed.\n",
+    "ds1307: read ram failed.\n",
+    "ds1307: write ram failed.\n",
+    "ds1307: flush ram cache failed.\n",
+    "ds1307: snapshot failed.\n",
+    "ds1307: time cache is disabled.\n",
+    "ds1307: register cache is disabled.\n",
+    "ds1307: sqw discipline is disabled.\n",
+    "ds1307: no sqw edge.\n",
+    "ds1307: sqw edge is lost.\n",
+    "ds1307: sqw is not locked.\n",
+    "ds1307: async operation is busy.\n",
+    "ds1307: async transport is not linked.\n",
+    "ds1307: async start failed.\n",
+    "ds1307: transaction is full.\n",
+    "ds1307: transaction commit failed.\n",
+    "ds1307: log buffer is not linked.\n",
+    "ds1307: region is invalid.\n",
+    "ds1307: get epoch failed.\n",
+    "ds1307: rebase failed.\n",
+    "ds1307: events is null.\n",
+    "ds1307: key is invalid.\n",
+    "ds1307: value is null.\n",
+    "ds1307: kv is full.\n",
+};
+#endif
+
+/**
+ * @brief     take the bus lock
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @note      does nothing when no lock is linked
+ */
+static void a_ds1307_lock(ds1307_handle_t *handle)
+{
+    if (handle->lock != NULL)                    /* check lock */
+    {
+        handle->lock(handle->user);              /* lock */
+    }
+}
+
+/**
+ * @brief     release the bus lock
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @note      does nothing when no unlock is linked
+ */
+static void a_ds1307_unlock(ds1307_handle_t *handle)
+{
+    if (handle->unlock != NULL)                  /* check unlock */
+    {
+        handle->unlock(handle->user);            /* unlock */
+    }
+}
+
+#if (DS1307_CONFIG_STATS != 0)
+/**
+ * @brief     get the stats start tick
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    start tick
+ * @note      0 when no stats_tick is linked
+ */
+static uint32_t a_ds1307_stats_start(ds1307_handle_t *handle)
+{
+    if (handle->stats_tick != NULL)                  /* check stats_tick */
+    {
+        return handle->stats_tick();                 /* get tick */
+    }
+    
+    return 0;                                        /* no tick */
+}
+
+/**
+ * @brief     count a bus transfer
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] op stats operation
+ * @param[in] in bytes read from the chip
+ * @param[in] out bytes written to the chip
+ * @note      called under the bus lock
+ */
+static void a_ds1307_stats_count(ds1307_handle_t *handle, uint8_t op, uint32_t in, uint32_t out)
+{
+    handle->stats.op[op].transaction++;              /* count transfer */
+    handle->stats.op[op].byte_in += in;              /* count input */
+    handle->stats.op[op].byte_out += out;            /* count output */
+}
+
+/**
+ * @brief     count the result and the latency of a bus transfer
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] op stats operation
+ * @param[in] res transfer result
+ * @param[in] start start tick
+ * @note      the 32 bit difference stays right when the tick wraps
+ */
+static void a_ds1307_stats_latency(ds1307_handle_t *handle, uint8_t op, uint8_t res, uint32_t start)
+{
+    uint32_t latency;
+    uint8_t bucket;
+    
+    if (res != 0)                                                  /* check result */
+    {
+        handle->stats.op[op].error++;                              /* count error */
+    }
+    if (handle->stats_tick == NULL)                                /* check stats_tick */
+    {
+        return;                                                    /* no histogram */
+    }
+    latency = handle->stats_tick() - start;                        /* get latency */
+    bucket = 0;                                                    /* init 0 */
+    while ((latency >> 1) != 0)                                    /* find the highest bit */
+    {
+        latency >>= 1;                                             /* next bit */
+        bucket++;                                                  /* next bucket */
+    }
+    handle->stats.op[op].histogram[bucket]++;                      /* count latency */
+}
+#endif
+
+#if (DS1307_CONFIG_TRACE != 0)
+/**
+ * @brief     get the trace tick
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    tick in ns
+ * @note      0 when no trace or no get_tick_ns is linked
+ */
+static uint64_t a_ds1307_trace_tick(ds1307_handle_t *handle)
+{
+    if ((handle->trace != NULL) && (handle->get_tick_ns != NULL))        /* check trace */
+    {
+        return handle->get_tick_ns();                                    /* get tick */
+    }
+    
+    return 0;                                                            /* no tick */
+}
+
+/**
+ * @brief     report a bus transfer to the trace
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *api pointer to the api context
+ * @param[in] read 1 for a read, 0 for a write
+ * @param[in] reg first register
+ * @param[in] len data length
+ * @param[in] lock tick when the bus lock was requested
+ * @param[in] start tick when the transport was called
+ * @param[in] res transport result
+ * @note      called after the bus lock is released, so the trace may block
+ */
+static void a_ds1307_trace(ds1307_handle_t *handle, const ds1307_api_t *api, uint8_t read, uint8_t reg,
+                           uint16_t len, uint64_t lock, uint64_t start, uint8_t res)
+{
+    ds1307_trace_t event;
+    
+    if (handle->trace == NULL)                                                   /* check trace */
+    {
+        return;                                                                  /* no trace */
+    }
+    event.end_ns = a_ds1307_trace_tick(handle);                                  /* get end tick */
+    event.api = api->name;                                                       /* set api */
+    event.read = read;                                                           /* set direction */
+    event.reg = reg;                                                             /* set register */
+    event.len = len;                                                             /* set length */
+    event.res = res;                                                             /* set result */
+    event.lock_ns = lock;                                                        /* set lock tick */
+    event.start_ns = start;                                                      /* set start tick */
+    handle->trace(handle->user, &event);                                         /* run trace */
+}
+#endif
+
+#if (DS1307_CONFIG_USDT != 0)
+/**
+ * @brief     fire the api return probe
+ * @param[in] **api pointer to the api name
+ * @note      run by the compiler on every return path of a public api
+ */
+static void a_ds1307_probe_return(const char **api)
+{
+    DTRACE_PROBE1(ds1307, api_return, *api);        /* api return probe */
+}
+#endif
+
+/**
+ * @brief     publish a time for lock free readers
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *t pointer to a time structure
+ * @note      writers are serialized by the bus lock
+ */
+static void a_ds1307_time_publish(ds1307_handle_t *handle, ds1307_time_t *t)
+{
+    uint64_t tick;
+    
+    tick = (handle->get_tick_ns != NULL) ? handle->get_tick_ns() : 0;        /* get tick */
+    a_ds1307_lock(handle);                                                   /* lock */
+    handle->time_pub_seq++;                                                  /* begin the update */
+    DS1307_MEMORY_BARRIER();                                                 /* publish the odd sequence first */
+    handle->time_pub = *t;                                                   /* save time */
+    handle->time_pub_tick = tick;                                            /* save tick */
+    DS1307_MEMORY_BARRIER();                                                 /* publish the data first */
+    handle->time_pub_seq++;                                                  /* finish the update */
+    a_ds1307_unlock(handle);                                                 /* unlock */
+}
+
+/**
+ * @brief     init the iic bus
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the ctx function wins when both are linked
+ */
+static uint8_t a_ds1307_bus_init(ds1307_handle_t *handle)
+{
+    uint8_t res;
+    
+    a_ds1307_lock(handle);                                             /* lock */
+    if (handle->iic_init_ctx != NULL)                                  /* check ctx */
+    {
+        res = handle->iic_init_ctx(handle->user);                      /* init with the context */
+    }
+    else
+    {
+        res = handle->iic_init();                                      /* init */
+    }
+    a_ds1307_unlock(handle);                                           /* unlock */
+    
+    return res;                                                        /* return result */
+}
+
+/**
+ * @brief     deinit the iic bus
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      the ctx function wins when both are linked
+ */
+static uint8_t a_ds1307_bus_deinit(ds1307_handle_t *handle)
+{
+    uint8_t res;
+    
+    a_ds1307_lock(handle);                                             /* lock */
+    if (handle->iic_deinit_ctx != NULL)                                /* check ctx */
+    {
+        res = handle->iic_deinit_ctx(handle->user);                    /* deinit with the context */
+    }
+    else
+    {
+        res = handle->iic_deinit();                                    /* deinit */
+    }
+    a_ds1307_unlock(handle);                                           /* unlock */
+    
+    return res;                                                        /* return result */
+}
+
+/**
+ * @brief      read the iic bus
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[in]  *api pointer to the api context
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the ctx function wins when both are linked
+ */
+static uint8_t a_ds1307_bus_read(ds1307_handle_t *handle, const ds1307_api_t *api, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint32_t start;
+    uint64_t lock_ns;
+    uint64_t start_ns;
+    
+    lock_ns = DS1307_TRACE_TICK(handle);                                               /* trace lock request */
+    a_ds1307_lock(handle);                                                             /* lock */
+    start = DS1307_STATS_START(handle);                                                /* stats start */
+    start_ns = DS1307_TRACE_TICK(handle);                                              /* trace transport start */
+    if (handle->iic_read_ctx != NULL)                                                  /* check ctx */
+    {
+        res = handle->iic_read_ctx(handle->user, DS1307_ADDRESS, reg, buf, len);       /* read with the context */
+    }
+    else
+    {
+        res = handle->iic_read(DS1307_ADDRESS, reg, buf, len);                         /* read */
+    }
+    DS1307_STATS_COUNT(handle, api->op, (uint32_t)len, 1);                             /* count transfer */
+    DS1307_STATS_LATENCY(handle, api->op, res, start);                                 /* count latency */
+    a_ds1307_unlock(handle);                                                           /* unlock */
+    DS1307_TRACE(handle, api, 1, reg, len, lock_ns, start_ns, res);                    /* trace transfer */
+    
+    return res;                                                                        /* return result */
+}
+
+/**
+ * @brief     write the iic bus
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *api pointer to the api context
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the ctx function wins when both are linked
+ */
+static uint8_t a_ds1307_bus_write(ds1307_handle_t *handle, const ds1307_api_t *api, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint32_t start;
+    uint64_t lock_ns;
+    uint64_t start_ns;
+    
+    lock_ns = DS1307_TRACE_TICK(handle);                                               /* trace lock request */
+    a_ds1307_lock(handle);                                                             /* lock */
+    start = DS1307_STATS_START(handle);                                                /* stats start */
+    start_ns = DS1307_TRACE_TICK(handle);                                              /* trace transport start */
+    if (handle->iic_write_ctx != NULL)                                                 /* check ctx */
+    {
+        res = handle->iic_write_ctx(handle->user, DS1307_ADDRESS, reg, buf, len);      /* write with the context */
+    }
+    else
+    {
+        res = handle->iic_write(DS1307_ADDRESS, reg, buf, len);                        /* write */
+    }
+    DS1307_STATS_COUNT(handle, api->op, 0, (uint32_t)len + 1);                         /* count transfer */
+    DS1307_STATS_LATENCY(handle, api->op, res, start);                                 /* count latency */
+    a_ds1307_unlock(handle);                                                           /* unlock */
+    DS1307_TRACE(handle, api, 0, reg, len, lock_ns, start_ns, res);                    /* trace transfer */
+    
+    return res;                                                                        /* return result */
+}
+
+/**
+ * @brief     copy written bytes into the bound snapshot
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @note      the register pointer wraps from 0x3F to 0x00
+ */
+static void a_ds1307_snapshot_update(ds1307_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    if (handle->snapshot != NULL)                                                  /* check snapshot */
+    {
+        for (i = 0; i < len; i++)                                                  /* all bytes */
+        {
+            handle->snapshot->reg[(reg + i) & 0x3F] = buf[i];                      /* update snapshot */
+        }
+    }
+}
+
 /**
  * @brief     write one byte
  * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *api pointer to the api context
  * @param[in] reg iic register address
  * @param[in] data written data
  * @return    status code
@@ -76,682 +665,4062 @@
  *            - 1 write failed
  * @note      none
  */
-static uint8_t a_ds1307_iic_write(ds1307_handle_t *handle, uint8_t reg, uint8_t data)
+static uint8_t a_ds1307_iic_write(ds1307_handle_t *handle, const ds1307_api_t *api, uint8_t reg, uint8_t data)
+{
+    if (a_ds1307_bus_write(handle, api, reg, &data, 1) != 0)               /* write data */
+    {
+        return 1;                                                          /* return error */
+    }
+    a_ds1307_snapshot_update(handle, reg, &data, 1);                       /* update snapshot */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     write multiple bytes
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *api pointer to the api context
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds1307_iic_multiple_write(ds1307_handle_t *handle, const ds1307_api_t *api, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    if (a_ds1307_bus_write(handle, api, reg, buf, len) != 0)              /* write data */
+    {
+        return 1;                                                         /* return error */
+    }
+    a_ds1307_snapshot_update(handle, reg, buf, len);                      /* update snapshot */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      read multiple bytes
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[in]  *api pointer to the api context
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       served from the bound snapshot without bus access
+ */
+static uint8_t a_ds1307_iic_multiple_read(ds1307_handle_t *handle, const ds1307_api_t *api, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    
+    if (handle->snapshot != NULL)                                    /* check snapshot */
+    {
+        for (i = 0; i < len; i++)                                    /* all bytes */
+        {
+            buf[i] = handle->snapshot->reg[(reg + i) & 0x3F];        /* read snapshot */
+        }
+        
+        return 0;                                                    /* success return 0 */
+    }
+    if (a_ds1307_bus_read(handle, api, reg, buf, len) != 0)          /* read data */
+    {
+        return 1;                                                    /* return error */
+    }
+    else
+    {                                                                /* success return 0 */
+        return 0;
+    }
+}
+
+/**
+ * @brief     hex to bcd
+ * @param[in] val hex data
+ * @return    bcd data
+ * @note      val < 100
+ */
+static uint8_t a_ds1307_hex2bcd(uint8_t val)
+{
+    return gs_hex2bcd[val];        /* return bcd */
+}
+
+/**
+ * @brief     bcd to hex
+ * @param[in] val bcd data
+ * @return    hex data
+ * @note      none
+ */
+static uint8_t a_ds1307_bcd2hex(uint8_t val)
+{
+    uint8_t tens;
+    
+    tens = val >> 4;                                  /* get tens place */
+    
+    return (uint8_t)(tens * 10 + (val & 0x0F));       /* tens * 10 + ones */
+}
+
+/**
+ * @brief     convert a date to days since 2000-01-01
+ * @param[in] year year in 2000 - 2099
+ * @param[in] month month in 1 - 12
+ * @param[in] date date in 1 - 31
+ * @return    days
+ * @note      every 4th year is a leap year in 2000 - 2099
+ */
+static uint32_t a_ds1307_date_to_days(uint16_t year, uint8_t month, uint8_t date)
+{
+    uint32_t y;
+    uint32_t days;
+    
+    y = (uint32_t)(year - 2000);                                          /* years since 2000 */
+    days = y * 365 + ((y + 3) >> 2);                                      /* whole years and their leap days */
+    days += gs_days_before_month[month - 1] + (uint32_t)(date - 1);       /* whole months and days */
+    days += (uint32_t)(((y & 0x3) == 0) && (month > 2));                  /* this year's leap day */
+    
+    return days;                                                          /* return days */
+}
+
+/**
+ * @brief      convert days since 2000-01-01 to a date
+ * @param[in]  days days since 2000-01-01
+ * @param[out] *year pointer to a year buffer
+ * @param[out] *month pointer to a month buffer
+ * @param[out] *date pointer to a date buffer
+ * @note       the year is counted from march so that the leap day closes every 4 years cycle
+ */
+static void a_ds1307_days_to_date(uint32_t days, uint16_t *year, uint8_t *month, uint8_t *date)
+{
+    uint32_t z;
+    uint32_t cycle;
+    uint32_t doc;
+    uint32_t yoc;
+    uint32_t doy;
+    uint32_t mp;
+    
+    z = days + 1401;                                      /* days since 1996-03-01 */
+    cycle = z / 1461;                                     /* 4 years cycles */
+    doc = z - cycle * 1461;                               /* day of cycle */
+    yoc = (doc - doc / 1460) / 365;                       /* year of cycle */
+    doy = doc - yoc * 365;                                /* day of year from march */
+    mp = (5 * doy + 2) / 153;                             /* month from march */
+    *date = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);      /* set date */
+    *month = (uint8_t)((mp < 10) ? (mp + 3) : (mp - 9));  /* set month */
+    *year = (uint16_t)(1996 + cycle * 4 + yoc + (*month <= 2));        /* set year */
+}
+
+/**
+ * @brief     convert the time of day of a time structure to seconds
+ * @param[in] *t pointer to a time structure
+ * @return    seconds since 00:00:00
+ * @note      only hour, minute, second, format and am_pm are used
+ */
+static uint32_t a_ds1307_time_to_second_of_day(ds1307_time_t *t)
+{
+    uint32_t hour;
+    
+    if (t->format == DS1307_FORMAT_12H)                                             /* if 12H */
+    {
+        hour = (t->hour == 12) ? 0 : t->hour;                                       /* 12 o'clock is 0 */
+        hour += (uint32_t)(t->am_pm) * 12;                                          /* convert to 24H */
+    }
+    else
+    {
+        hour = t->hour;                                                             /* 24H */
+    }
+    
+    return hour * 3600 + (uint32_t)(t->minute) * 60 + t->second;                    /* return seconds */
+}
+
+/**
+ * @brief     convert a time structure to seconds since 2000-01-01 00:00:00
+ * @param[in] *t pointer to a time structure
+ * @return    seconds
+ * @note      none
+ */
+static uint32_t a_ds1307_time_to_second(ds1307_time_t *t)
+{
+    return a_ds1307_date_to_days(t->year, t->month, t->date) * 86400 +
+           a_ds1307_time_to_second_of_day(t);                                       /* return seconds */
+}
+
+/**
+ * @brief      convert seconds since 2000-01-01 00:00:00 to a time structure
+ * @param[in]  second seconds
+ * @param[in]  format hour format
+ * @param[out] *t pointer to a time structure
+ * @note       the week is derived from the date, 2000-01-01 is a saturday
+ */
+static void a_ds1307_second_to_time(uint32_t second, ds1307_format_t format, ds1307_time_t *t)
+{
+    uint32_t days;
+    uint32_t rem;
+    uint8_t hour;
+    
+    days = second / 86400;                                                    /* get days */
+    rem = second - days * 86400;                                              /* get second of day */
+    a_ds1307_days_to_date(days, &t->year, &t->month, &t->date);               /* get date */
+    t->week = (uint8_t)((days + 5) % 7 + 1);                                  /* get week */
+    hour = (uint8_t)(rem / 3600);                                             /* get hour */
+    rem -= (uint32_t)hour * 3600;                                             /* get second of hour */
+    t->minute = (uint8_t)(rem / 60);                                          /* get minute */
+    t->second = (uint8_t)(rem - (uint32_t)(t->minute) * 60);                  /* get second */
+    t->format = format;                                                       /* set format */
+    if (format == DS1307_FORMAT_12H)                                          /* if 12H */
+    {
+        t->am_pm = (ds1307_am_pm_t)(hour >= 12);                              /* set am pm */
+        t->hour = (uint8_t)(hour % 12);                                       /* set hour */
+        if (t->hour == 0)                                                     /* if 0 */
+        {
+            t->hour = 12;                                                     /* 12 o'clock */
+        }
+    }
+    else
+    {
+        t->am_pm = (ds1307_am_pm_t)((a_ds1307_hex2bcd(hour) >> 5) & 0x01);    /* bit 5 of the hour register */
+        t->hour = hour;                                                       /* set hour */
+    }
+}
+
+/**
+ * @brief      decode the seven time registers
+ * @param[in]  *buf pointer to the time registers
+ * @param[out] *t pointer to a time structure
+ * @note       none
+ */
+static void a_ds1307_time_decode(uint8_t *buf, ds1307_time_t *t)
+{
+    t->year = a_ds1307_bcd2hex(buf[6]) + 2000;                         /* get year */
+    t->month = a_ds1307_bcd2hex(buf[5] & 0x1F);                        /* get month */
+    t->week = a_ds1307_bcd2hex(buf[3] & 0x7);                          /* get week */
+    t->date = a_ds1307_bcd2hex(buf[4] & 0x3F);                         /* get date */
+    t->am_pm = (ds1307_am_pm_t)((buf[2] >> 5) & 0x01);                 /* get am pm */
+    t->format = (ds1307_format_t)((buf[2] >> 6) & 0x01);               /* get format */
+    if (t->format == DS1307_FORMAT_12H)                                /* if 12H */
+    {
+        t->hour = a_ds1307_bcd2hex(buf[2] & 0x1F);                     /* get hour */
+    }
+    else
+    {
+        t->hour = a_ds1307_bcd2hex(buf[2] & 0x3F);                     /* get hour */
+    }
+    t->minute = a_ds1307_bcd2hex(buf[1]);                              /* get minute */
+    t->second = a_ds1307_bcd2hex(buf[0] & (~(1 << 7)));                /* get second */
+}
+
+/**
+ * @brief     get the ordering key of a raw time
+ * @param[in] *reg pointer to the time registers
+ * @return    key, larger is later
+ * @note      bcd digits keep their order, only the hour needs converting to 24h
+ */
+static uint64_t a_ds1307_raw_key(uint8_t *reg)
+{
+    uint8_t hour;
+    
+    if (((reg[2] >> 6) & 0x01) != 0)                                                        /* if 12H */
+    {
+        hour = a_ds1307_bcd2hex(reg[2] & 0x1F);                                             /* get 12h hour */
+        hour = (uint8_t)(((hour == 12) ? 0 : hour) + ((reg[2] >> 5) & 0x01) * 12);         /* 12h to 24h */
+    }
+    else
+    {
+        hour = a_ds1307_bcd2hex(reg[2] & 0x3F);                                             /* 24h */
+    }
+    
+    return ((uint64_t)reg[6] << 40) | ((uint64_t)(reg[5] & 0x1F) << 32) |
+           ((uint64_t)(reg[4] & 0x3F) << 24) | ((uint64_t)hour << 16) |
+           ((uint64_t)(reg[1] & 0x7F) << 8) | (uint64_t)(reg[0] & 0x7F);                  /* year down to second */
+}
+
+/**
+ * @brief     check a time structure
+ * @param[in] *t pointer to a time structure
+ * @return    error bits, 0 means the time is valid
+ * @note      the same comparisons run for both hour formats
+ */
+static uint8_t a_ds1307_time_check(ds1307_time_t *t)
+{
+    uint8_t err;
+    uint8_t format;
+    uint8_t month;
+    uint8_t days;
+    
+    format = (uint8_t)(t->format) & 0x01;                                                           /* table index */
+    month = (uint8_t)(t->month * (t->month <= 12));                                                 /* table index */
+    days = gs_days_in_month[month] + (uint8_t)((month == 2) & ((t->year & 0x3) == 0));              /* days of the month */
+    err = (uint8_t)(((uint16_t)(t->year - 2000) > 99) * DS1307_TIME_ERROR_YEAR);                    /* check year */
+    err |= (uint8_t)((month == 0) * DS1307_TIME_ERROR_MONTH);                                       /* check month */
+    err |= (uint8_t)(((uint8_t)(t->week - 1) > 6) * DS1307_TIME_ERROR_WEEK);                        /* check week */
+    err |= (uint8_t)(((uint8_t)(t->date - 1) >= days) * DS1307_TIME_ERROR_DATE);                    /* check date */
+    err |= (uint8_t)(((uint8_t)(t->hour - gs_hour_min[format]) >
+                      gs_hour_span[format]) * DS1307_TIME_ERROR_HOUR);                              /* check hour */
+    err |= (uint8_t)((t->minute > 59) * DS1307_TIME_ERROR_MINUTE);                                  /* check minute */
+    err |= (uint8_t)((t->second > 59) * DS1307_TIME_ERROR_SECOND);                                  /* check second */
+    err |= (uint8_t)(((uint32_t)(t->format) > 1) * DS1307_TIME_ERROR_FORMAT);                       /* check format */
+    
+    return err;                                                                                     /* return error bits */
+}
+
+/**
+ * @brief     update the time cache anchor
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *t pointer to a time structure
+ * @param[in] ch clock halt bit
+ * @param[in] tick tick of the chip sample
+ * @note      a halted clock or an out of range time is never cached, the anchor is swapped under the lock
+ */
+static void a_ds1307_time_cache_update(ds1307_handle_t *handle, ds1307_time_t *t, uint8_t ch, uint64_t tick)
+{
+    uint32_t second;
+    uint8_t valid;
+    
+    second = 0;                                                                                          /* init 0 */
+    valid = 0;                                                                                           /* init 0 */
+    if ((handle->time_cache != 0) && (ch == 0) && (a_ds1307_time_check(t) == 0))                         /* check cache, ch and time */
+    {
+        second = a_ds1307_time_to_second(t);                                                             /* get anchor */
+        valid = 1;                                                                                       /* flag valid */
+    }
+    a_ds1307_lock(handle);                                                                               /* lock */
+    handle->time_cache_valid = 0;                                                                        /* drop cache */
+    if (valid != 0)                                                                                      /* check valid */
+    {
+        handle->time_cache_second = second;                                                              /* save anchor */
+        handle->time_cache_week = t->week;                                                               /* save week */
+        handle->time_cache_format = (uint8_t)(t->format);                                                /* save format */
+        handle->time_cache_tick = tick;                                                                  /* save tick */
+        handle->time_cache_valid = 1;                                                                    /* flag valid */
+    }
+    a_ds1307_unlock(handle);                                                                             /* unlock */
+}
+
+/**
+ * @brief      get the time from the time cache
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 cache is empty or stale
+ * @note       the anchor is copied under the lock
+ */
+static uint8_t a_ds1307_time_cache_get(ds1307_handle_t *handle, ds1307_time_t *t)
+{
+    uint64_t elapsed;
+    uint64_t tick;
+    uint32_t anchor;
+    uint32_t second;
+    uint32_t days;
+    uint8_t valid;
+    uint8_t week;
+    uint8_t format;
+    
+    a_ds1307_lock(handle);                                                                 /* lock */
+    valid = handle->time_cache_valid;                                                      /* copy valid */
+    anchor = handle->time_cache_second;                                                    /* copy anchor */
+    week = handle->time_cache_week;                                                        /* copy week */
+    format = handle->time_cache_format;                                                    /* copy format */
+    tick = handle->time_cache_tick;                                                        /* copy tick */
+    a_ds1307_unlock(handle);                                                               /* unlock */
+    if (valid == 0)                                                                        /* check cache */
+    {
+        return 1;                                                                          /* return error */
+    }
+    elapsed = handle->get_tick_ns() - tick;                                                /* get elapsed time */
+    if (elapsed >= (uint64_t)(handle->time_cache_interval_ms) * 1000000ULL)                /* check interval */
+    {
+        return 1;                                                                          /* return error */
+    }
+    second = anchor + (uint32_t)(elapsed / 1000000000ULL);                                 /* extrapolate */
+    a_ds1307_second_to_time(second, (ds1307_format_t)(format), t);                         /* convert */
+    days = second / 86400 - anchor / 86400;                                                /* days since anchor */
+    t->week = (uint8_t)((week - 1 + days) % 7 + 1);                                        /* keep the chip's week */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      sample the sqw edge counter and its tick
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *edge pointer to an edge counter buffer
+ * @param[out] *tick pointer to an edge tick buffer
+ * @note       retries until no edge arrived while sampling
+ */
+static void a_ds1307_sqw_sample(ds1307_handle_t *handle, uint32_t *edge, uint64_t *tick)
+{
+    uint32_t seq;
+    uint32_t check;
+    
+    do
+    {
+        seq = handle->sqw_seq;                                 /* get sequence */
+        DS1307_MEMORY_BARRIER();                               /* read the sequence first */
+        *tick = handle->sqw_edge_tick;                         /* get tick */
+        DS1307_MEMORY_BARRIER();                               /* read the data first */
+        check = handle->sqw_seq;                               /* get sequence again */
+    } while ((check != seq) || ((seq & 0x01) != 0));           /* retry while an edge is written */
+    *edge = seq >> 1;                                          /* get edge counter */
+}
+
+/**
+ * @brief     get the ram mirror bitmap of a range
+ * @param[in] addr ram address
+ * @param[in] len data length
+ * @return    bitmap
+ * @note      addr + len <= 56
+ */
+static uint64_t a_ds1307_ram_mask(uint8_t addr, uint8_t len)
+{
+    if (len == 0)                                                       /* check len */
+    {
+        return 0;                                                       /* empty range */
+    }
+    
+    return (((uint64_t)1 << len) - 1) << addr;                          /* return bitmap */
+}
+
+/**
+ * @brief     write the dirty ram mirror bytes back
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *api pointer to the api context
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      bursts that failed stay dirty
+ */
+static uint8_t a_ds1307_ram_flush(ds1307_handle_t *handle, const ds1307_api_t *api)
+{
+    uint8_t start;
+    uint8_t end;
+    uint8_t i;
+    uint64_t mask;
+    
+    start = 0;                                                                            /* init 0 */
+    while (handle->ram_dirty != 0)                                                        /* until clean */
+    {
+        while (((handle->ram_dirty >> start) & 0x01) == 0)                                /* find the first dirty byte */
+        {
+            start++;                                                                      /* next byte */
+        }
+        end = start;                                                                      /* last dirty byte of the burst */
+        for (i = (uint8_t)(start + 1); (i < 56) && (i - end <= DS1307_RAM_CACHE_GAP + 1); i++)
+        {
+            if (((handle->ram_dirty >> i) & 0x01) != 0)                                   /* check dirty */
+            {
+                end = i;                                                                  /* extend the burst */
+            }
+        }
+        mask = a_ds1307_ram_mask(start, (uint8_t)(end - start + 1));                      /* burst bitmap */
+        if (a_ds1307_iic_multiple_write(handle, api, (uint8_t)(DS1307_REG_RAM + start),
+                                        &handle->ram[start], (uint8_t)(end - start + 1)) != 0)        /* write the burst */
+        {
+            return 1;                                                                     /* return error */
+        }
+        handle->ram_dirty &= ~mask;                                                       /* flag clean */
+        start = (uint8_t)(end + 1);                                                       /* next burst */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     drop the cached registers covered by a write
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] reg iic register address
+ * @param[in] len data length
+ * @note      the register pointer wraps from 0x3F to 0x00
+ */
+static void a_ds1307_reg_cache_drop(ds1307_handle_t *handle, uint8_t reg, uint16_t len)
+{
+    if ((uint8_t)((DS1307_REG_SECOND - reg) & 0x3F) < len)                 /* check second */
+    {
+        handle->reg_cache_valid &= (uint8_t)(~DS1307_REG_CACHE_CH);         /* drop ch */
+    }
+    if (((reg & 0x3F) <= DS1307_REG_YEAR) ||
+        ((uint8_t)((DS1307_REG_SECOND - reg) & 0x3F) < len))               /* check time */
+    {
+        handle->time_cache_valid = 0;                                       /* drop time */
+        handle->sqw_anchor_valid = 0;                                       /* drop sqw anchor */
+    }
+    if ((uint8_t)((DS1307_REG_CONTROL - reg) & 0x3F) < len)                /* check control */
+    {
+        handle->reg_cache_valid &= (uint8_t)(~DS1307_REG_CACHE_CONTROL);    /* drop control */
+    }
+}
+
+/**
+ * @brief     update the cached clock halt bit
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] second second register value
+ * @note      none
+ */
+static void a_ds1307_reg_cache_second(ds1307_handle_t *handle, uint8_t second)
+{
+    if (handle->reg_cache != 0)                                  /* check cache */
+    {
+        a_ds1307_lock(handle);                                   /* lock */
+        handle->ch = (second >> 7) & 0x01;                       /* save ch */
+        handle->reg_cache_valid |= DS1307_REG_CACHE_CH;          /* flag valid */
+        a_ds1307_unlock(handle);                                 /* unlock */
+    }
+}
+
+/**
+ * @brief      read the clock halt bit
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[in]  *api pointer to the api context
+ * @param[out] *ch pointer to a clock halt bit buffer
+ * @param[in]  rmw 1 if the bit is read for a read-modify-write
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       served from the register cache when it is valid, a read-modify-write
+ *             never uses the bound snapshot and only bus data fills the cache
+ */
+static uint8_t a_ds1307_read_ch(ds1307_handle_t *handle, const ds1307_api_t *api, uint8_t *ch, uint8_t rmw)
+{
+    uint8_t prev;
+    
+    if ((handle->reg_cache_valid & DS1307_REG_CACHE_CH) != 0)                         /* check cache */
+    {
+        *ch = handle->ch;                                                        /* get ch */
+        
+        return 0;                                                                     /* success return 0 */
+    }
+    if ((handle->snapshot != NULL) && (rmw == 0))                                     /* check snapshot */
+    {
+        *ch = (handle->snapshot->reg[DS1307_REG_SECOND] >> 7) & 0x01;            /* get ch */
+        
+        return 0;                                                                     /* success return 0 */
+    }
+    if (a_ds1307_bus_read(handle, api, DS1307_REG_SECOND, &prev, 1) != 0)             /* read second */
+    {
+        return 1;                                                                     /* return error */
+    }
+    a_ds1307_reg_cache_second(handle, prev);                                          /* update cache */
+    *ch = (prev >> 7) & 0x01;                                                    /* get ch */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      read the control register
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[in]  *api pointer to the api context
+ * @param[out] *control pointer to a control buffer
+ * @param[in]  rmw 1 if the register is read for a read-modify-write
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       served from the register cache when it is valid, a read-modify-write
+ *             never uses the bound snapshot and only bus data fills the cache
+ */
+static uint8_t a_ds1307_read_control(ds1307_handle_t *handle, const ds1307_api_t *api, uint8_t *control, uint8_t rmw)
+{
+    if ((handle->reg_cache_valid & DS1307_REG_CACHE_CONTROL) != 0)                      /* check cache */
+    {
+        *control = handle->control;                                                /* get control */
+        
+        return 0;                                                                       /* success return 0 */
+    }
+    if ((handle->snapshot != NULL) && (rmw == 0))                                       /* check snapshot */
+    {
+        *control = handle->snapshot->reg[DS1307_REG_CONTROL];                      /* get control */
+        
+        return 0;                                                                       /* success return 0 */
+    }
+    if (a_ds1307_bus_read(handle, api, DS1307_REG_CONTROL, control, 1) != 0)            /* read control */
+    {
+        return 1;                                                                       /* return error */
+    }
+    if (handle->reg_cache != 0)                                                         /* check cache */
+    {
+        handle->control = *control;                                                     /* save control */
+        handle->reg_cache_valid |= DS1307_REG_CACHE_CONTROL;                            /* flag valid */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     write the control register
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *api pointer to the api context
+ * @param[in] control control register value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds1307_write_control(ds1307_handle_t *handle, const ds1307_api_t *api, uint8_t control)
+{
+    if (a_ds1307_iic_write(handle, api, DS1307_REG_CONTROL, control) != 0)           /* write control */
+    {
+        handle->reg_cache_valid &= (uint8_t)(~DS1307_REG_CACHE_CONTROL);             /* drop control */
+        
+        return 1;                                                                    /* return error */
+    }
+    if (handle->reg_cache != 0)                                                      /* check cache */
+    {
+        handle->control = control;                                                   /* save control */
+        handle->reg_cache_valid |= DS1307_REG_CACHE_CONTROL;                         /* flag valid */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     check a time and print every error
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *t pointer to a time structure
+ * @return    error bits
+ * @note      none
+ */
+static uint8_t a_ds1307_time_check_print(ds1307_handle_t *handle, ds1307_time_t *t)
+{
+    uint8_t err;
+    uint8_t i;
+    
+    err = a_ds1307_time_check(t);                                                       /* check time */
+    for (i = 0; i < 8; i++)                                                             /* print every error */
+    {
+        if (((err >> i) & 0x01) != 0)                                                   /* check the bit */
+        {
+            DS1307_LOG(handle, (ds1307_log_t)(DS1307_LOG_YEAR_IS_INVALID + i), 0);      /* print the error */
+        }
+    }
+    
+    return err;                                                                         /* return error bits */
+}
+
+/**
+ * @brief      encode a time into the seven time registers
+ * @param[in]  *t pointer to a checked time structure
+ * @param[in]  ch clock halt bit
+ * @param[out] *buf pointer to a 7 bytes buffer
+ * @note       none
+ */
+static void a_ds1307_time_encode(ds1307_time_t *t, uint8_t ch, uint8_t *buf)
+{
+    buf[0] = a_ds1307_hex2bcd(t->second) | (uint8_t)(ch << 7);                               /* set second and keep ch */
+    buf[1] = a_ds1307_hex2bcd(t->minute);                                                    /* set minute */
+    if (t->format == DS1307_FORMAT_12H)                                                      /* if 12H */
+    {
+        buf[2] = (uint8_t)((1 << 6) | (t->am_pm << 5) | a_ds1307_hex2bcd(t->hour));          /* set hour in 12H */
+    }
+    else                                                                                     /* if 24H */
+    {
+        buf[2] = (0 << 6) | a_ds1307_hex2bcd(t->hour);                                       /* set hour in 24H */
+    }
+    buf[3] = a_ds1307_hex2bcd(t->week);                                                      /* set week */
+    buf[4] = a_ds1307_hex2bcd(t->date);                                                      /* set date */
+    buf[5] = a_ds1307_hex2bcd(t->month);                                                     /* set month */
+    buf[6] = a_ds1307_hex2bcd((uint8_t)(t->year - 2000));                                    /* set year */
+}
+
+/**
+ * @brief     check whether an async operation can start
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ * @note      none
+ */
+static uint8_t a_ds1307_async_check(ds1307_handle_t *handle)
+{
+    if (handle->async_op != DS1307_ASYNC_IDLE)                                 /* check busy */
+    {
+        DS1307_LOG(handle, DS1307_LOG_ASYNC_OPERATION_IS_BUSY, 0);             /* async operation is busy */
+        
+        return 4;                                                              /* return error */
+    }
+    DS1307_MEMORY_BARRIER();                                                   /* read the idle flag first */
+    if ((handle->iic_read_async == NULL) || (handle->iic_write_async == NULL)) /* check transport */
+    {
+        DS1307_LOG(handle, DS1307_LOG_ASYNC_TRANSPORT_IS_NOT_LINKED, 0);       /* async transport is not linked */
+        
+        return 5;                                                              /* return error */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     start an async transfer
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] read 1 for read, 0 for write
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the transport may complete before it returns, so nothing of the
+ *            operation state is touched after the call
+ */
+static uint8_t a_ds1307_async_transfer(ds1307_handle_t *handle, uint8_t read, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    DS1307_STATS_ASYNC_START(handle);                                                                /* stats start */
+    if (read != 0)                                                                                   /* check direction */
+    {
+        DS1307_STATS_COUNT(handle, DS1307_STATS_OP_ASYNC, len, 1);                                   /* count transfer */
+        
+        return handle->iic_read_async(handle->user, DS1307_ADDRESS, reg, buf, len, handle);          /* start read */
+    }
+    DS1307_STATS_COUNT(handle, DS1307_STATS_OP_ASYNC, 0, (uint32_t)len + 1);                         /* count transfer */
+    
+    return handle->iic_write_async(handle->user, DS1307_ADDRESS, reg, buf, len, handle);             /* start write */
+}
+
+/**
+ * @brief     finish the async operation
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] res operation result
+ * @note      the handle is idle again before the callback runs, so the callback may start the next operation
+ */
+static void a_ds1307_async_finish(ds1307_handle_t *handle, uint8_t res)
+{
+    ds1307_async_callback_t callback;
+    void *arg;
+    
+    callback = handle->async_callback;                         /* save callback */
+    arg = handle->async_arg;                                   /* save argument */
+    DS1307_MEMORY_BARRIER();                                   /* publish the results first */
+    handle->async_op = DS1307_ASYNC_IDLE;                      /* flag idle */
+    if (callback != NULL)                                      /* check callback */
+    {
+        callback(handle, res, arg);                            /* run callback */
+    }
+}
+
+/**
+ * @brief     start an async operation
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] op async operation
+ * @param[in] reg iic register address
+ * @param[in] len data length
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the first transfer of a write is a write, every other operation starts with a read
+ */
+static uint8_t a_ds1307_async_start(ds1307_handle_t *handle, uint8_t op, uint8_t reg, uint8_t len,
+                                    ds1307_async_callback_t callback, void *arg)
+{
+    uint8_t *buf;
+    
+    handle->async_step = 0;                                                                      /* first step */
+    handle->async_reg = reg;                                                                     /* save register */
+    handle->async_len = len;                                                                     /* save length */
+    handle->async_callback = callback;                                                           /* save callback */
+    handle->async_arg = arg;                                                                     /* save argument */
+    DS1307_MEMORY_BARRIER();                                                                     /* publish the operation first */
+    handle->async_op = op;                                                                       /* flag busy */
+    buf = (op == DS1307_ASYNC_READ) ? handle->async_out : handle->async_buf;                     /* transfer buffer */
+    if (op == DS1307_ASYNC_SET_TIME)                                                             /* check set time */
+    {
+        buf = &handle->async_buf[7];                                                             /* second register scratch */
+    }
+    if (a_ds1307_async_transfer(handle, (op == DS1307_ASYNC_WRITE) ? 0 : 1, reg, buf, len) != 0) /* start transfer */
+    {
+        handle->async_op = DS1307_ASYNC_IDLE;                                                    /* flag idle */
+        DS1307_LOG(handle, DS1307_LOG_ASYNC_START_FAILED, 0);                                    /* async start failed */
+        
+        return 1;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     update the driver state after a write outside the blocking paths
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to the written data
+ * @param[in] len data length
+ * @note      mirrors what the blocking write paths keep coherent
+ */
+static void a_ds1307_bus_written(ds1307_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint8_t addr;
+    
+    a_ds1307_snapshot_update(handle, reg, buf, len);                                       /* update snapshot */
+    for (i = 0; i < len; i++)                                                              /* all bytes */
+    {
+        addr = (uint8_t)((reg + i) & 0x3F);                                                /* wrapped address */
+        if (addr == DS1307_REG_SECOND)                                                     /* if second */
+        {
+            a_ds1307_reg_cache_second(handle, buf[i]);                                     /* update ch */
+        }
+        else if ((addr == DS1307_REG_CONTROL) && (handle->reg_cache != 0))                 /* if control */
+        {
+            handle->control = buf[i];                                                      /* save control */
+            handle->reg_cache_valid |= DS1307_REG_CACHE_CONTROL;                           /* flag valid */
+        }
+        else if ((addr >= DS1307_REG_RAM) &&
+                 (handle->ram_cache != DS1307_RAM_CACHE_DISABLE))                          /* if cached ram */
+        {
+            handle->ram[addr - DS1307_REG_RAM] = buf[i];                                   /* update the mirror */
+            handle->ram_dirty &= ~((uint64_t)1 << (addr - DS1307_REG_RAM));                /* flag clean */
+        }
+        else
+        {
+            
+        }
+    }
+}
+
+/**
+ * @brief      reserve messages and data in a transaction
+ * @param[in]  *tr pointer to a transaction structure
+ * @param[in]  msg_num message number
+ * @param[in]  data_len data length
+ * @param[out] **data pointer to a data pointer
+ * @return     status code
+ *             - 0 success
+ *             - 1 transaction is full
+ * @note       none
+ */
+static uint8_t a_ds1307_transaction_reserve(ds1307_transaction_t *tr, uint8_t msg_num, uint8_t data_len, uint8_t **data)
+{
+    if ((tr->msg_num + msg_num > DS1307_TRANSACTION_MAX_MSG) ||
+        (tr->data_len + data_len > DS1307_TRANSACTION_MAX_DATA))                  /* check space */
+    {
+        DS1307_LOG(tr->handle, DS1307_LOG_TRANSACTION_IS_FULL, 0);                 /* transaction is full */
+        
+        return 1;                                                                 /* return error */
+    }
+    *data = &tr->data[tr->data_len];                                              /* data pointer */
+    tr->data_len = (uint8_t)(tr->data_len + data_len);                            /* use data */
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     queue a message in a transaction
+ * @param[in] *tr pointer to a transaction structure
+ * @param[in] flags message flag
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] op decode operation
+ * @param[in] *out decode destination
+ * @note      the space must be reserved first
+ */
+static void a_ds1307_transaction_queue(ds1307_transaction_t *tr, uint8_t flags, uint8_t *buf, uint16_t len,
+                                       uint8_t op, void *out)
+{
+    tr->msg[tr->msg_num].addr = DS1307_ADDRESS;        /* set address */
+    tr->msg[tr->msg_num].flags = flags;                /* set flags */
+    tr->msg[tr->msg_num].len = len;                    /* set length */
+    tr->msg[tr->msg_num].buf = buf;                    /* set buffer */
+    tr->op[tr->msg_num] = op;                          /* set operation */
+    tr->out[tr->msg_num] = out;                        /* set destination */
+    tr->msg_num++;                                     /* next message */
+}
+
+/**
+ * @brief      queue a register read in a transaction
+ * @param[in]  *tr pointer to a transaction structure
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer, NULL reads into the transaction data
+ * @param[in]  len data length
+ * @param[in]  op decode operation
+ * @param[in]  *out decode destination
+ * @return     status code
+ *             - 0 success
+ *             - 1 transaction is full
+ * @note       none
+ */
+static uint8_t a_ds1307_transaction_read(ds1307_transaction_t *tr, uint8_t reg, uint8_t *buf, uint8_t len,
+                                         uint8_t op, void *out)
+{
+    uint8_t *data;
+    
+    if (a_ds1307_transaction_reserve(tr, 2, (uint8_t)((buf == NULL) ? (len + 1) : 1), &data) != 0)        /* reserve */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    data[0] = reg;                                                                                     /* set register */
+    a_ds1307_transaction_queue(tr, DS1307_IIC_MSG_WRITE, data, 1, DS1307_TRANSACTION_RAW, NULL);      /* queue address */
+    a_ds1307_transaction_queue(tr, DS1307_IIC_MSG_READ, (buf == NULL) ? &data[1] : buf, len, op, out); /* queue read */
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     queue a register write in a transaction
+ * @param[in] *tr pointer to a transaction structure
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 transaction is full
+ * @note      the data is copied
+ */
+static uint8_t a_ds1307_transaction_write(ds1307_transaction_t *tr, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    uint8_t *data;
+    
+    if (a_ds1307_transaction_reserve(tr, 1, (uint8_t)(len + 1), &data) != 0)                          /* reserve */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    data[0] = reg;                                                                                     /* set register */
+    memcpy(&data[1], buf, len);                                                                        /* copy data */
+    a_ds1307_transaction_queue(tr, DS1307_IIC_MSG_WRITE, data, (uint16_t)(len + 1),
+                               DS1307_TRANSACTION_RAW, NULL);                                          /* queue write */
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     check whether a message is the address of a following read
+ * @param[in] *tr pointer to a transaction structure
+ * @param[in] i message index
+ * @return    1 if it is, 0 if not
+ * @note      none
+ */
+static uint8_t a_ds1307_transaction_is_address(ds1307_transaction_t *tr, uint8_t i)
+{
+    return (uint8_t)((i + 1 < tr->msg_num) && (tr->msg[i + 1].flags == DS1307_IIC_MSG_READ));
+}
+
+/**
+ * @brief     update the driver state after a committed transaction
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *tr pointer to a transaction structure
+ * @param[in] tick tick taken before the transfer
+ * @note      none
+ */
+static void a_ds1307_transaction_done(ds1307_handle_t *handle, ds1307_transaction_t *tr, uint64_t tick)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t reg;
+    uint8_t control;
+    uint8_t *buf;
+    ds1307_time_t *t;
+    ds1307_output_config_t *config;
+    
+    for (i = 0; i < tr->msg_num; i++)                                                                    /* all messages */
+    {
+        buf = tr->msg[i].buf;                                                                            /* message data */
+        if (tr->msg[i].flags == DS1307_IIC_MSG_WRITE)                                                    /* if write */
+        {
+            if (a_ds1307_transaction_is_address(tr, i) == 0)                                             /* check write */
+            {
+                a_ds1307_reg_cache_drop(handle, buf[0], (uint16_t)(tr->msg[i].len - 1));                 /* drop cache */
+                a_ds1307_bus_written(handle, buf[0], &buf[1], (uint8_t)(tr->msg[i].len - 1));            /* update state */
+            }
+            
+            continue;                                                                                    /* next message */
+        }
+        reg = tr->msg[i - 1].buf[0];                                                                     /* register address */
+        for (j = 0; j < tr->msg[i].len; j++)                                                             /* all bytes */
+        {
+            if ((uint8_t)((reg + j) & 0x3F) == DS1307_REG_SECOND)                                        /* if second */
+            {
+                a_ds1307_reg_cache_second(handle, buf[j]);                                               /* update ch */
+            }
+            else if (((uint8_t)((reg + j) & 0x3F) == DS1307_REG_CONTROL) && (handle->reg_cache != 0))    /* if control */
+            {
+                handle->control = buf[j];                                                                /* save control */
+                handle->reg_cache_valid |= DS1307_REG_CACHE_CONTROL;                                     /* flag valid */
+            }
+            else if ((((reg + j) & 0x3F) >= DS1307_REG_RAM) &&
+                     (((handle->ram_dirty >> (((reg + j) & 0x3F) - DS1307_REG_RAM)) & 0x01) != 0))       /* if dirty ram */
+            {
+                buf[j] = handle->ram[((reg + j) & 0x3F) - DS1307_REG_RAM];                               /* the mirror wins */
+            }
+            else
+            {
+                
+            }
+        }
+        if (tr->op[i] == DS1307_TRANSACTION_TIME)                                                        /* if time */
+        {
+            t = (ds1307_time_t *)tr->out[i];                                                             /* time */
+            a_ds1307_time_decode(buf, t);                                                                /* decode time */
+            if (handle->time_cache != 0)                                                                 /* check time cache */
+            {
+                a_ds1307_time_cache_update(handle, t, (buf[0] >> 7) & 0x01, tick);                       /* update time cache */
+            }
+            a_ds1307_time_publish(handle, t);                                                            /* publish time */
+        }
+        else if (tr->op[i] == DS1307_TRANSACTION_CONTROL)                                                /* if control */
+        {
+            config = (ds1307_output_config_t *)tr->out[i];                                               /* config */
+            control = buf[0];                                                                            /* control */
+            config->level = (ds1307_output_level_t)((control >> 7) & 0x01);                              /* get level */
+            config->mode = (ds1307_output_mode_t)((control >> 4) & 0x01);                                /* get mode */
+            config->freq = (ds1307_square_wave_frequency_t)((control >> 0) & 0x03);                      /* get freq */
+        }
+        else
+        {
+            
+        }
+    }
+}
+
+/**
+ * @brief     set the current time
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *t pointer to a time structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set time failed
+ *            - 2 handle or time is NULL
+ *            - 3 handle is not initialized
+ *            - 4 time is invalid
+ * @note      all seven time registers are written in one burst
+ */
+uint8_t ds1307_set_time(ds1307_handle_t *handle, ds1307_time_t *t)
+{
+    uint8_t res;
+    uint8_t reg;
+    uint8_t buf[7];
+    uint64_t tick;
+    
+    DS1307_PROBE_ENTER(handle);                                                                                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                                              /* check handle */
+    {
+        return 2;                                                                                                  /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                                                         /* check handle initialization */
+    {
+        return 3;                                                                                                  /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_SET_TIME);                                                                    /* api entry */
+    if (DS1307_CHECK(t == NULL))                                                                                   /* check time */
+    {
+        DS1307_LOG(handle, DS1307_LOG_TIME_IS_NULL, 0);                                                            /* time is null */
+        
+        return 2;                                                                                                  /* return error */
+    }
+    if (DS1307_CHECK(a_ds1307_time_check_print(handle, t) != 0))                                                   /* check time */
+    {
+        return 4;                                                                                                  /* return error */
+    }
+    
+    res = a_ds1307_read_ch(handle, &api, &reg, 1);                                                                 /* read ch */
+    if (res != 0)                                                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_SECOND_FAILED, 0);                                                      /* read second failed */
+        
+        return 1;                                                                                                  /* return error */
+    }
+    a_ds1307_time_encode(t, reg, buf);                                                                             /* encode time */
+    tick = 0;                                                                                                      /* init 0 */
+    if (handle->time_cache != 0)                                                                                   /* check time cache */
+    {
+        tick = handle->get_tick_ns();                                                                              /* get tick */
+    }
+    res = a_ds1307_iic_multiple_write(handle, &api, DS1307_REG_SECOND, buf, 7);                                    /* write all time registers */
+    if (res != 0)                                                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_WRITE_TIME_FAILED, 0);                                                       /* write time failed */
+        a_ds1307_reg_cache_drop(handle, DS1307_REG_SECOND, 7);                                                     /* drop cache */
+        
+        return 1;                                                                                                  /* return error */
+    }
+    handle->sqw_anchor_valid = 0;                                                                                  /* drop sqw anchor */
+    a_ds1307_time_cache_update(handle, t, reg, tick);                                                              /* update time cache */
+    a_ds1307_time_publish(handle, t);                                                                              /* publish time */
+    
+    return 0;                                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the current time
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ * @note       served from the time cache when it is enabled and fresh
+ */
+uint8_t ds1307_get_time(ds1307_handle_t *handle, ds1307_time_t *t)
+{
+    uint8_t res;
+    uint8_t buf[7];
+    uint64_t tick;
+    
+    DS1307_PROBE_ENTER(handle);                                                                 /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                           /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                                      /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_GET_TIME);                                                 /* api entry */
+    if (DS1307_CHECK(t == NULL))                                                                /* check time */
+    {
+        DS1307_LOG(handle, DS1307_LOG_TIME_IS_NULL, 0);                                         /* time is null */
+        
+        return 2;                                                                               /* return error */
+    }
+    
+    tick = 0;                                                                                   /* init 0 */
+    if ((handle->time_cache != 0) && (handle->snapshot == NULL))                                /* check time cache */
+    {
+        if (a_ds1307_time_cache_get(handle, t) == 0)                                            /* get cached time */
+        {
+            return 0;                                                                           /* success return 0 */
+        }
+        tick = handle->get_tick_ns();                                                           /* get tick */
+    }
+    memset(buf, 0, sizeof(uint8_t) * 7);                                                        /* clear the buffer */
+    res = a_ds1307_iic_multiple_read(handle, &api, DS1307_REG_SECOND, (uint8_t *)buf, 7);       /* multiple_read */
+    if (res != 0)                                                                               /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_MULTIPLE_READ_FAILED, 0);                                 /* multiple read failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    if (handle->snapshot == NULL)                                                               /* only bus data fills the cache */
+    {
+        a_ds1307_reg_cache_second(handle, buf[0]);                                              /* update cache */
+    }
+    a_ds1307_time_decode(buf, t);                                                               /* decode time */
+    if ((handle->time_cache != 0) && (handle->snapshot == NULL))                                /* check time cache */
+    {
+        a_ds1307_time_cache_update(handle, t, (buf[0] >> 7) & 0x01, tick);                      /* update time cache */
+    }
+    if (handle->snapshot == NULL)                                                               /* check snapshot */
+    {
+        a_ds1307_time_publish(handle, t);                                                       /* publish time */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     set the time by a unix epoch
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] epoch seconds since 1970-01-01 00:00:00
+ * @return    status code
+ *            - 0 success
+ *            - 1 set epoch failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 epoch is invalid
+ * @note      2000-01-01 <= epoch < 2100-01-01, the time is written in 24H format
+ *            and the week is derived from the date
+ */
+uint8_t ds1307_set_epoch(ds1307_handle_t *handle, uint32_t epoch)
+{
+    ds1307_time_t t;
+    
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (DS1307_CHECK((epoch < DS1307_EPOCH_2000) || (epoch >= DS1307_EPOCH_2100)))       /* check epoch */
+    {
+        DS1307_LOG(handle, DS1307_LOG_EPOCH_IS_INVALID, 0);                              /* epoch is invalid */
+        
+        return 4;                                                                        /* return error */
+    }
+    
+    a_ds1307_second_to_time(epoch - DS1307_EPOCH_2000, DS1307_FORMAT_24H, &t);           /* convert */
+    if (ds1307_set_time(handle, &t) != 0)                                                /* set time */
+    {
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the time as a unix epoch
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *epoch pointer to a seconds since 1970-01-01 00:00:00 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get epoch failed
+ *             - 2 handle or epoch is NULL
+ *             - 3 handle is not initialized
+ * @note       the chip's week register is ignored
+ */
+uint8_t ds1307_get_epoch(ds1307_handle_t *handle, uint32_t *epoch)
+{
+    ds1307_time_t t;
+    
+    DS1307_PROBE_ENTER(handle);                                              /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                        /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                   /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    if (DS1307_CHECK(epoch == NULL))                                         /* check epoch */
+    {
+        DS1307_LOG(handle, DS1307_LOG_EPOCH_IS_NULL, 0);                     /* epoch is null */
+        
+        return 2;                                                            /* return error */
+    }
+    
+    if (ds1307_get_time(handle, &t) != 0)                                    /* get time */
+    {
+        return 1;                                                            /* return error */
+    }
+    t.week = 1;                                                              /* the week is not used */
+    if (a_ds1307_time_check(&t) != 0)                                        /* check time */
+    {
+        DS1307_LOG(handle, DS1307_LOG_TIME_IS_INVALID, 0);                   /* time is invalid */
+        
+        return 1;                                                            /* return error */
+    }
+    *epoch = a_ds1307_time_to_second(&t) + DS1307_EPOCH_2000;                /* convert */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the last published time
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure
+ * @param[out] *tick pointer to a tick buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no time is published
+ * @note       ds1307_get_time and ds1307_set_time publish the time, this function never
+ *             touches the bus or the lock, *tick is 0 when get_tick_ns is not linked
+ */
+uint8_t ds1307_get_last_time(ds1307_handle_t *handle, ds1307_time_t *t, uint64_t *tick)
+{
+    uint32_t seq;
+    
+    DS1307_PROBE_ENTER(handle);                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                    /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                               /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if (DS1307_CHECK((t == NULL) || (tick == NULL)))                     /* check time and tick */
+    {
+        DS1307_LOG(handle, DS1307_LOG_TIME_IS_NULL, 0);                  /* time is null */
+        
+        return 2;                                                        /* return error */
+    }
+    
+    do
+    {
+        seq = handle->time_pub_seq;                                      /* get sequence */
+        DS1307_MEMORY_BARRIER();                                         /* read the sequence first */
+        *t = handle->time_pub;                                           /* get time */
+        *tick = handle->time_pub_tick;                                   /* get tick */
+        DS1307_MEMORY_BARRIER();                                         /* read the data first */
+    } while (((seq & 0x01) != 0) || (seq != handle->time_pub_seq));      /* retry while a writer publishes */
+    if (seq == 0)                                                        /* check published */
+    {
+        return 4;                                                        /* return error */
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the seconds
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *second pointer to a second buffer
+ * @param[out] *halt pointer to a clock halt bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get second failed
+ *             - 2 handle, second or halt is NULL
+ *             - 3 handle is not initialized
+ * @note       one register is transferred
+ */
+uint8_t ds1307_get_second(ds1307_handle_t *handle, uint8_t *second, ds1307_bool_t *halt)
+{
+    uint8_t res;
+    uint8_t reg;
+    
+    DS1307_PROBE_ENTER(handle);                                                       /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                 /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                            /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_GET_TIME);                                       /* api entry */
+    if (DS1307_CHECK((second == NULL) || (halt == NULL)))                             /* check second and halt */
+    {
+        DS1307_LOG(handle, DS1307_LOG_SECOND_IS_NULL, 0);                             /* second is null */
+        
+        return 2;                                                                     /* return error */
+    }
+    
+    res = a_ds1307_iic_multiple_read(handle, &api, DS1307_REG_SECOND, &reg, 1);       /* read second */
+    if (res != 0)                                                                     /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_SECOND_FAILED, 0);                         /* read second failed */
+        
+        return 1;                                                                     /* return error */
+    }
+    if (handle->snapshot == NULL)                                                     /* only bus data fills the cache */
+    {
+        a_ds1307_reg_cache_second(handle, reg);                                       /* update cache */
+    }
+    *second = a_ds1307_bcd2hex(reg & 0x7F);                                     /* get second */
+    *halt = (ds1307_bool_t)((reg >> 7) & 0x01);                                 /* get ch */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the time of day
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time of day failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ * @note       three registers are transferred, only hour, minute, second,
+ *             format and am_pm are written
+ */
+uint8_t ds1307_get_time_of_day(ds1307_handle_t *handle, ds1307_time_t *t)
+{
+    uint8_t res;
+    uint8_t buf[3];
+    
+    DS1307_PROBE_ENTER(handle);                                                       /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                 /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                            /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_GET_TIME);                                       /* api entry */
+    if (DS1307_CHECK(t == NULL))                                                      /* check time */
+    {
+        DS1307_LOG(handle, DS1307_LOG_TIME_IS_NULL, 0);                               /* time is null */
+        
+        return 2;                                                                     /* return error */
+    }
+    
+    res = a_ds1307_iic_multiple_read(handle, &api, DS1307_REG_SECOND, buf, 3);        /* read hh:mm:ss */
+    if (res != 0)                                                                     /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_MULTIPLE_READ_FAILED, 0);                       /* multiple read failed */
+        
+        return 1;                                                                     /* return error */
+    }
+    if (handle->snapshot == NULL)                                                     /* only bus data fills the cache */
+    {
+        a_ds1307_reg_cache_second(handle, buf[0]);                                    /* update cache */
+    }
+    t->am_pm = (ds1307_am_pm_t)((buf[2] >> 5) & 0x01);                                /* get am pm */
+    t->format = (ds1307_format_t)((buf[2] >> 6) & 0x01);                              /* get format */
+    if (t->format == DS1307_FORMAT_12H)                                               /* if 12H */
+    {
+        t->hour = a_ds1307_bcd2hex(buf[2] & 0x1F);                                    /* get hour */
+    }
+    else
+    {
+        t->hour = a_ds1307_bcd2hex(buf[2] & 0x3F);                                    /* get hour */
+    }
+    t->minute = a_ds1307_bcd2hex(buf[1] & 0x7F);                                      /* get minute */
+    t->second = a_ds1307_bcd2hex(buf[0] & 0x7F);                                      /* get second */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the date
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get date failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ * @note       four registers are transferred, only year, month, date and week are written
+ */
+uint8_t ds1307_get_date(ds1307_handle_t *handle, ds1307_time_t *t)
+{
+    uint8_t res;
+    uint8_t buf[4];
+    
+    DS1307_PROBE_ENTER(handle);                                                       /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                 /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                            /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_GET_TIME);                                       /* api entry */
+    if (DS1307_CHECK(t == NULL))                                                      /* check time */
+    {
+        DS1307_LOG(handle, DS1307_LOG_TIME_IS_NULL, 0);                               /* time is null */
+        
+        return 2;                                                                     /* return error */
+    }
+    
+    res = a_ds1307_iic_multiple_read(handle, &api, DS1307_REG_WEEK, buf, 4);          /* read week to year */
+    if (res != 0)                                                                     /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_MULTIPLE_READ_FAILED, 0);                       /* multiple read failed */
+        
+        return 1;                                                                     /* return error */
+    }
+    t->week = a_ds1307_bcd2hex(buf[0] & 0x07);                                        /* get week */
+    t->date = a_ds1307_bcd2hex(buf[1] & 0x3F);                                        /* get date */
+    t->month = a_ds1307_bcd2hex(buf[2] & 0x1F);                                       /* get month */
+    t->year = a_ds1307_bcd2hex(buf[3]) + 2000;                                        /* get year */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the seconds elapsed between two second samples
+ * @param[in]  start first second sample
+ * @param[in]  stop second second sample
+ * @param[out] *elapsed pointer to an elapsed seconds buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 elapsed is NULL
+ *             - 4 second is invalid
+ * @note       one minute wrap is handled, the samples must be less than a minute apart
+ */
+uint8_t ds1307_get_elapsed_second(uint8_t start, uint8_t stop, uint8_t *elapsed)
+{
+    DS1307_PROBE_ENTER(NULL);                                         /* probe entry and exit */
+    if (DS1307_CHECK(elapsed == NULL))                                /* check elapsed */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (DS1307_CHECK((start > 59) || (stop > 59)))                    /* check second */
+    {
+        return 4;                                                     /* return error */
+    }
+    
+    *elapsed = (uint8_t)((stop >= start) ? (stop - start) :
+                         (stop + 60 - start));                        /* handle the minute wrap */
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the seconds elapsed between two time of day samples
+ * @param[in]  *start pointer to the first time structure
+ * @param[in]  *stop pointer to the second time structure
+ * @param[out] *elapsed pointer to an elapsed seconds buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 start, stop or elapsed is NULL
+ * @note       only hour, minute, second, format and am_pm are used,
+ *             one midnight wrap is handled
+ */
+uint8_t ds1307_get_elapsed_time_of_day(ds1307_time_t *start, ds1307_time_t *stop, uint32_t *elapsed)
+{
+    uint32_t a;
+    uint32_t b;
+    
+    DS1307_PROBE_ENTER(NULL);                                                        /* probe entry and exit */
+    if (DS1307_CHECK((start == NULL) || (stop == NULL) || (elapsed == NULL)))        /* check start, stop and elapsed */
+    {
+        return 2;                                                                    /* return error */
+    }
+    
+    a = a_ds1307_time_to_second_of_day(start);                                       /* second of day */
+    b = a_ds1307_time_to_second_of_day(stop);                                        /* second of day */
+    *elapsed = (b >= a) ? (b - a) : (b + 86400 - a);                                 /* handle the midnight wrap */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      get the raw time registers
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *raw pointer to a raw time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get raw time failed
+ *             - 2 handle or raw is NULL
+ *             - 3 handle is not initialized
+ * @note       one burst read, nothing is decoded
+ */
+uint8_t ds1307_get_raw_time(ds1307_handle_t *handle, ds1307_raw_time_t *raw)
+{
+    uint8_t res;
+    
+    DS1307_PROBE_ENTER(handle);                                                              /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                        /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                                   /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_GET_TIME);                                              /* api entry */
+    if (DS1307_CHECK(raw == NULL))                                                           /* check raw */
+    {
+        DS1307_LOG(handle, DS1307_LOG_RAW_IS_NULL, 0);                                       /* raw is null */
+        
+        return 2;                                                                            /* return error */
+    }
+    
+    res = a_ds1307_iic_multiple_read(handle, &api, DS1307_REG_SECOND, raw->reg, 7);          /* multiple_read */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_MULTIPLE_READ_FAILED, 0);                              /* multiple read failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    if (handle->snapshot == NULL)                                                            /* only bus data fills the cache */
+    {
+        a_ds1307_reg_cache_second(handle, raw->reg[0]);                                      /* update cache */
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief      decode one field of a raw time
+ * @param[in]  *raw pointer to a raw time structure
+ * @param[in]  field raw time field
+ * @param[out] *value pointer to a field value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 raw or value is NULL
+ *             - 4 field is invalid
+ * @note       the year is returned as 2000 - 2099
+ */
+uint8_t ds1307_raw_time_get_field(ds1307_raw_time_t *raw, ds1307_raw_field_t field, uint16_t *value)
+{
+    DS1307_PROBE_ENTER(NULL);                                                                       /* probe entry and exit */
+    if (DS1307_CHECK((raw == NULL) || (value == NULL)))                                             /* check raw and value */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    
+    if (field <= DS1307_RAW_FIELD_YEAR)                                                             /* register fields */
+    {
+        if ((field == DS1307_RAW_FIELD_HOUR) && (((raw->reg[2] >> 6) & 0x01) != 0))                 /* 12h hour */
+        {
+            *value = a_ds1307_bcd2hex(raw->reg[2] & 0x1F);                                          /* get hour */
+            
+            return 0;                                                                               /* success return 0 */
+        }
+        *value = a_ds1307_bcd2hex(raw->reg[field] & gs_raw_field_mask[field]);                      /* get field */
+        if (field == DS1307_RAW_FIELD_YEAR)                                                         /* if year */
+        {
+            *value += 2000;                                                                         /* add 2000 */
+        }
+    }
+    else if (field == DS1307_RAW_FIELD_FORMAT)                                                      /* format */
+    {
+        *value = (raw->reg[2] >> 6) & 0x01;                                                         /* get format */
+    }
+    else if (field == DS1307_RAW_FIELD_AM_PM)                                                       /* am pm */
+    {
+        *value = ((raw->reg[2] >> 6) & (raw->reg[2] >> 5)) & 0x01;                                  /* pm only in 12h */
+    }
+    else if (field == DS1307_RAW_FIELD_HOUR_24)                                                     /* 24h hour */
+    {
+        *value = (uint16_t)((a_ds1307_raw_key(raw->reg) >> 16) & 0xFF);                             /* get hour */
+    }
+    else
+    {
+        return 4;                                                                                   /* return error */
+    }
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      decode a raw time
+ * @param[in]  *raw pointer to a raw time structure
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 raw or time is NULL
+ * @note       none
+ */
+uint8_t ds1307_raw_time_decode(ds1307_raw_time_t *raw, ds1307_time_t *t)
+{
+    DS1307_PROBE_ENTER(NULL);                              /* probe entry and exit */
+    if (DS1307_CHECK((raw == NULL) || (t == NULL)))        /* check raw and time */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    a_ds1307_time_decode(raw->reg, t);                     /* decode time */
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief      compare two raw times
+ * @param[in]  *a pointer to a raw time structure
+ * @param[in]  *b pointer to a raw time structure
+ * @param[out] *result pointer to a result buffer, -1 a is earlier, 0 equal, 1 a is later
+ * @return     status code
+ *             - 0 success
+ *             - 2 a, b or result is NULL
+ * @note       the clock halt bit and the week are ignored, 12h and 24h samples compare correctly
+ */
+uint8_t ds1307_raw_time_compare(ds1307_raw_time_t *a, ds1307_raw_time_t *b, int8_t *result)
+{
+    uint64_t ka;
+    uint64_t kb;
+    
+    DS1307_PROBE_ENTER(NULL);                                                /* probe entry and exit */
+    if (DS1307_CHECK((a == NULL) || (b == NULL) || (result == NULL)))        /* check a, b and result */
+    {
+        return 2;                                                            /* return error */
+    }
+    
+    ka = a_ds1307_raw_key(a->reg);                                           /* get key a */
+    kb = a_ds1307_raw_key(b->reg);                                           /* get key b */
+    *result = (int8_t)((ka > kb) - (ka < kb));                               /* compare */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the oscillator
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set oscillator failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1307_set_oscillator(ds1307_handle_t *handle, ds1307_bool_t enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                                         /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                   /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                              /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_WRITE_CONTROL);                                    /* api entry */
+    
+    if (((handle->reg_cache_valid & DS1307_REG_CACHE_CH) != 0) &&
+        (handle->ch == (uint8_t)(!enable)))                                             /* check cache */
+    {
+        return 0;                                                                       /* already set */
+    }
+    res = a_ds1307_bus_read(handle, &api, DS1307_REG_SECOND, &prev, 1);                 /* read second, never from a snapshot */
+    if (res != 0)                                                                       /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_SECOND_FAILED, 0);                           /* read second failed */
+        
+        return 1;                                                                       /* return error */
+    }
+    prev &= ~(1 << 7);                                                                  /* clear config */
+    prev |= (!enable) << 7;                                                             /* set enable */
+    res = a_ds1307_iic_write(handle, &api, DS1307_REG_SECOND, prev);                    /* write second */
+    if (res != 0)                                                                       /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_WRITE_SECOND_FAILED, 0);                          /* write second failed */
+        a_ds1307_reg_cache_drop(handle, DS1307_REG_SECOND, 1);                          /* drop cache */
+        
+        return 1;                                                                       /* return error */
+    }
+    a_ds1307_reg_cache_second(handle, prev);                                            /* update cache */
+    handle->time_cache_valid = 0;                                                       /* drop time cache */
+    handle->sqw_anchor_valid = 0;                                                       /* drop sqw anchor */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the chip oscillator status
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get oscillator failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_oscillator(ds1307_handle_t *handle, ds1307_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                                              /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                        /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                                   /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_READ_CONTROL);                                          /* api entry */
+    
+    res = a_ds1307_read_ch(handle, &api, &prev, 0);                                          /* read ch */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_SECOND_FAILED, 0);                                /* read second failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    *enable = (ds1307_bool_t)(!prev);                                                        /* get enable */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     set the output level
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] level output level
+ * @return    status code
+ *            - 0 success
+ *            - 1 set output level failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1307_set_output_level(ds1307_handle_t *handle, ds1307_output_level_t level)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                              /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                         /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_WRITE_CONTROL);                               /* api entry */
+    
+    res = a_ds1307_read_control(handle, &api, &prev, 1);                           /* read control */
+    if (res != 0)                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_CONTROL_FAILED, 0);                     /* read control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    prev &= ~(1 << 7);                                                             /* clear config */
+    prev |= level << 7;                                                            /* set setting */
+    res = a_ds1307_write_control(handle, &api, prev);                              /* write control */
+    if (res != 0)                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_WRITE_CONTROL_FAILED, 0);                    /* write control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the output level
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *level pointer to an output level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get output level failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_output_level(ds1307_handle_t *handle, ds1307_output_level_t *level)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                              /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                         /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_READ_CONTROL);                                /* api entry */
+    
+    res = a_ds1307_read_control(handle, &api, &prev, 0);                           /* read control */
+    if (res != 0)                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_CONTROL_FAILED, 0);                     /* read control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    *level = (ds1307_output_level_t)((prev >> 7) & 0x01);                          /* set level */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the output mode
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] mode output mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set output mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1307_set_output_mode(ds1307_handle_t *handle, ds1307_output_mode_t mode)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                              /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                         /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_WRITE_CONTROL);                               /* api entry */
+    
+    res = a_ds1307_read_control(handle, &api, &prev, 1);                           /* read control */
+    if (res != 0)                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_CONTROL_FAILED, 0);                     /* read control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    prev &= ~(1 << 4);                                                             /* clear config */
+    prev |= mode << 4;                                                             /* set setting */
+    res = a_ds1307_write_control(handle, &api, prev);                              /* write control */
+    if (res != 0)                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_WRITE_CONTROL_FAILED, 0);                    /* write control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the output mode
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *mode pointer to an output mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get output mode failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_output_mode(ds1307_handle_t *handle, ds1307_output_mode_t *mode)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                              /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                         /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_READ_CONTROL);                                /* api entry */
+    
+    res = a_ds1307_read_control(handle, &api, &prev, 0);                           /* read control */
+    if (res != 0)                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_CONTROL_FAILED, 0);                     /* read control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    *mode = (ds1307_output_mode_t)((prev >> 4) & 0x01);                            /* set mode */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the square wave frequency
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] freq square wave frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 set square wave frequency failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1307_set_square_wave_frequency(ds1307_handle_t *handle, ds1307_square_wave_frequency_t freq)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                              /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                         /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_WRITE_CONTROL);                               /* api entry */
+    
+    res = a_ds1307_read_control(handle, &api, &prev, 1);                           /* read control */
+    if (res != 0)                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_CONTROL_FAILED, 0);                     /* read control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    prev &= ~(3 << 0);                                                             /* clear config */
+    prev |= freq << 0;                                                             /* set setting */
+    res = a_ds1307_write_control(handle, &api, prev);                              /* write control */
+    if (res != 0)                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_WRITE_CONTROL_FAILED, 0);                    /* write control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the square wave frequency
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *freq pointer to a square wave frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get square wave frequency failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_square_wave_frequency(ds1307_handle_t *handle, ds1307_square_wave_frequency_t *freq)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                              /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                         /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_READ_CONTROL);                                /* api entry */
+    
+    res = a_ds1307_read_control(handle, &api, &prev, 0);                           /* read control */
+    if (res != 0)                                                                  /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_CONTROL_FAILED, 0);                     /* read control failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    *freq = (ds1307_square_wave_frequency_t)(prev & 0x3);                          /* set freq */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the output level, mode and square wave frequency
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *config pointer to an output config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set output config failed
+ *            - 2 handle or config is NULL
+ *            - 3 handle is not initialized
+ * @note      the whole control register is written at once
+ */
+uint8_t ds1307_set_output_config(ds1307_handle_t *handle, ds1307_output_config_t *config)
+{
+    uint8_t res;
+    uint8_t control;
+    
+    DS1307_PROBE_ENTER(handle);                                                       /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                 /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                            /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_WRITE_CONTROL);                                  /* api entry */
+    if (DS1307_CHECK(config == NULL))                                                 /* check config */
+    {
+        DS1307_LOG(handle, DS1307_LOG_CONFIG_IS_NULL, 0);                             /* config is null */
+        
+        return 2;                                                                     /* return error */
+    }
+    
+    control = (uint8_t)(((config->level & 0x01) << 7) |
+                        ((config->mode & 0x01) << 4) |
+                        ((config->freq & 0x03) << 0));                                /* set control */
+    res = a_ds1307_write_control(handle, &api, control);                              /* write control */
+    if (res != 0)                                                                     /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_WRITE_CONTROL_FAILED, 0);                       /* write control failed */
+        
+        return 1;                                                                     /* return error */
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the output level, mode and square wave frequency
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *config pointer to an output config structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get output config failed
+ *             - 2 handle or config is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_output_config(ds1307_handle_t *handle, ds1307_output_config_t *config)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                                     /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                               /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                          /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_READ_CONTROL);                                 /* api entry */
+    if (DS1307_CHECK(config == NULL))                                               /* check config */
+    {
+        DS1307_LOG(handle, DS1307_LOG_CONFIG_IS_NULL, 0);                           /* config is null */
+        
+        return 2;                                                                   /* return error */
+    }
+    
+    res = a_ds1307_read_control(handle, &api, &prev, 0);                            /* read control */
+    if (res != 0)                                                                   /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_CONTROL_FAILED, 0);                      /* read control failed */
+        
+        return 1;                                                                   /* return error */
+    }
+    config->level = (ds1307_output_level_t)((prev >> 7) & 0x01);                    /* get level */
+    config->mode = (ds1307_output_mode_t)((prev >> 4) & 0x01);                      /* get mode */
+    config->freq = (ds1307_square_wave_frequency_t)(prev & 0x3);                    /* get freq */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     restore an output profile
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] profile raw control register value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set output profile failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 profile is invalid
+ * @note      none
+ */
+uint8_t ds1307_set_output_profile(ds1307_handle_t *handle, uint8_t profile)
+{
+    uint8_t res;
+    
+    DS1307_PROBE_ENTER(handle);                                           /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                     /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_WRITE_CONTROL);                      /* api entry */
+    if (DS1307_CHECK((profile & (uint8_t)(~DS1307_CONTROL_MASK)) != 0))   /* check profile */
+    {
+        DS1307_LOG(handle, DS1307_LOG_PROFILE_IS_INVALID, profile);       /* profile is invalid */
+        
+        return 4;                                                         /* return error */
+    }
+    
+    res = a_ds1307_write_control(handle, &api, profile);                  /* write control */
+    if (res != 0)                                                         /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_WRITE_CONTROL_FAILED, 0);           /* write control failed */
+        
+        return 1;                                                         /* return error */
+    }
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      save the output profile
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *profile pointer to a raw control register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get output profile failed
+ *             - 2 handle or profile is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_output_profile(ds1307_handle_t *handle, uint8_t *profile)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    DS1307_PROBE_ENTER(handle);                                           /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                     /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_READ_CONTROL);                       /* api entry */
+    if (DS1307_CHECK(profile == NULL))                                    /* check profile */
+    {
+        DS1307_LOG(handle, DS1307_LOG_PROFILE_IS_NULL, 0);                /* profile is null */
+        
+        return 2;                                                         /* return error */
+    }
+    
+    res = a_ds1307_read_control(handle, &api, &prev, 0);                  /* read control */
+    if (res != 0)                                                         /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_CONTROL_FAILED, 0);            /* read control failed */
+        
+        return 1;                                                         /* return error */
+    }
+    *profile = prev & DS1307_CONTROL_MASK;                                /* get profile */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the time cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_tick_ns is NULL
+ * @note      when enabled, ds1307_get_time extrapolates the last chip sample with
+ *            the host tick and only reads the chip once the resync interval expired
+ */
+uint8_t ds1307_set_time_cache(ds1307_handle_t *handle, ds1307_bool_t enable)
+{
+    DS1307_PROBE_ENTER(handle);                                            /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                      /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                 /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if ((enable == DS1307_BOOL_TRUE) && (handle->get_tick_ns == NULL))     /* check get_tick_ns */
+    {
+        DS1307_LOG(handle, DS1307_LOG_GET_TICK_NS_IS_NULL, 0);             /* get_tick_ns is null */
+        
+        return 4;                                                          /* return error */
+    }
+    
+    handle->time_cache = (uint8_t)enable;                                  /* set cache */
+    handle->time_cache_valid = 0;                                          /* drop cache */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the time cache status
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_time_cache(ds1307_handle_t *handle, ds1307_bool_t *enable)
+{
+    DS1307_PROBE_ENTER(handle);                               /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                         /* check handle */
+    {
+        return 2;                                             /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                    /* check handle initialization */
+    {
+        return 3;                                             /* return error */
+    }
+    
+    *enable = (ds1307_bool_t)(handle->time_cache);            /* get cache */
+    
+    return 0;                                                 /* success return 0 */
+}
+
+/**
+ * @brief     set the time cache resync interval
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] ms resync interval in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      this is the maximum age of the chip sample behind a cached time
+ */
+uint8_t ds1307_set_time_cache_interval(ds1307_handle_t *handle, uint32_t ms)
+{
+    DS1307_PROBE_ENTER(handle);                   /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))             /* check handle */
+    {
+        return 2;                                 /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))        /* check handle initialization */
+    {
+        return 3;                                 /* return error */
+    }
+    
+    handle->time_cache_interval_ms = ms;          /* set interval */
+    
+    return 0;                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the time cache resync interval
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *ms pointer to a resync interval buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_time_cache_interval(ds1307_handle_t *handle, uint32_t *ms)
+{
+    DS1307_PROBE_ENTER(handle);                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))              /* check handle */
+    {
+        return 2;                                  /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))         /* check handle initialization */
+    {
+        return 3;                                  /* return error */
+    }
+    
+    *ms = handle->time_cache_interval_ms;          /* get interval */
+    
+    return 0;                                      /* success return 0 */
+}
+
+/**
+ * @brief     refresh the time cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh time cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 time cache is disabled
+ * @note      none
+ */
+uint8_t ds1307_refresh_time_cache(ds1307_handle_t *handle)
+{
+    ds1307_time_t t;
+    
+    DS1307_PROBE_ENTER(handle);                                        /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                  /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                             /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    if (handle->time_cache == 0)                                       /* check cache */
+    {
+        DS1307_LOG(handle, DS1307_LOG_TIME_CACHE_IS_DISABLED, 0);      /* time cache is disabled */
+        
+        return 4;                                                      /* return error */
+    }
+    
+    handle->time_cache_valid = 0;                                      /* drop cache */
+    if (ds1307_get_time(handle, &t) != 0)                              /* read the chip */
+    {
+        return 1;                                                      /* return error */
+    }
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     set the ram cache policy
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] policy ram cache policy
+ * @return    status code
+ *            - 0 success
+ *            - 1 set ram cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 policy is invalid
+ * @note      enabling loads the whole ram in one burst, leaving write back flushes it first
+ */
+uint8_t ds1307_set_ram_cache(ds1307_handle_t *handle, ds1307_ram_cache_t policy)
+{
+    DS1307_PROBE_ENTER(handle);                                                                 /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                           /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                                      /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_WRITE_RAM);                                                /* api entry */
+    if (DS1307_CHECK(policy > DS1307_RAM_CACHE_WRITE_BACK))                                     /* check policy */
+    {
+        DS1307_LOG(handle, DS1307_LOG_POLICY_IS_INVALID, policy);                               /* policy is invalid */
+        
+        return 4;                                                                               /* return error */
+    }
+    
+    if (a_ds1307_ram_flush(handle, &api) != 0)                                                  /* flush dirty bytes */
+    {
+        DS1307_LOG(handle, DS1307_LOG_FLUSH_RAM_CACHE_FAILED, 0);                               /* flush ram cache failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    if ((handle->ram_cache == DS1307_RAM_CACHE_DISABLE) &&
+        (policy != DS1307_RAM_CACHE_DISABLE))                                                   /* check load */
+    {
+        if (a_ds1307_bus_read(handle, &api, DS1307_REG_RAM, handle->ram, 56) != 0)              /* load the mirror */
+        {
+            DS1307_LOG(handle, DS1307_LOG_READ_RAM_FAILED, 0);                                  /* read ram failed */
+            
+            return 1;                                                                           /* return error */
+        }
+    }
+    handle->ram_cache = (uint8_t)policy;                                                        /* set policy */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the ram cache policy
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *policy pointer to a ram cache policy buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_ram_cache(ds1307_handle_t *handle, ds1307_ram_cache_t *policy)
+{
+    DS1307_PROBE_ENTER(handle);                                  /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                            /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                       /* check handle initialization */
+    {
+        return 3;                                                /* return error */
+    }
+    
+    *policy = (ds1307_ram_cache_t)(handle->ram_cache);           /* get policy */
+    
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief     flush the dirty ram mirror bytes
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush ram cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      dirty runs closer than a burst header are merged into one burst
+ */
+uint8_t ds1307_flush_ram_cache(ds1307_handle_t *handle)
+{
+    DS1307_PROBE_ENTER(handle);                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                    /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                               /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_WRITE_RAM);                         /* api entry */
+    
+    if (a_ds1307_ram_flush(handle, &api) != 0)                           /* flush dirty bytes */
+    {
+        DS1307_LOG(handle, DS1307_LOG_FLUSH_RAM_CACHE_FAILED, 0);        /* flush ram cache failed */
+        
+        return 1;                                                        /* return error */
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the sqw discipline
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set sqw discipline failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_tick_ns is NULL
+ * @note      enabling switches the SQW/OUT pin to the 1Hz square wave,
+ *            disabling leaves the output config untouched
+ */
+uint8_t ds1307_set_sqw_discipline(ds1307_handle_t *handle, ds1307_bool_t enable)
+{
+    ds1307_output_config_t config;
+    
+    DS1307_PROBE_ENTER(handle);                                            /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                      /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                 /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if ((enable == DS1307_BOOL_TRUE) && (handle->get_tick_ns == NULL))     /* check get_tick_ns */
+    {
+        DS1307_LOG(handle, DS1307_LOG_GET_TICK_NS_IS_NULL, 0);             /* get_tick_ns is null */
+        
+        return 4;                                                          /* return error */
+    }
+    
+    handle->sqw = 0;                                                       /* stop the irq handler */
+    handle->sqw_seq = 0;                                                   /* clear edges */
+    handle->sqw_edge_tick = 0;                                             /* clear tick */
+    handle->sqw_anchor_valid = 0;                                          /* drop anchor */
+    if (enable == DS1307_BOOL_FALSE)                                       /* if disable */
+    {
+        return 0;                                                          /* success return 0 */
+    }
+    config.level = DS1307_OUTPUT_LEVEL_LOW;                                /* low level */
+    config.mode = DS1307_OUTPUT_MODE_SQUARE_WAVE;                          /* square wave */
+    config.freq = DS1307_SQUARE_WAVE_FREQUENCY_1_HZ;                       /* 1Hz */
+    if (ds1307_set_output_config(handle, &config) != 0)                    /* set output config */
+    {
+        DS1307_LOG(handle, DS1307_LOG_SET_OUTPUT_CONFIG_FAILED, 0);        /* set output config failed */
+        
+        return 1;                                                          /* return error */
+    }
+    handle->sqw = 1;                                                       /* start the irq handler */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the sqw discipline status
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_sqw_discipline(ds1307_handle_t *handle, ds1307_bool_t *enable)
+{
+    DS1307_PROBE_ENTER(handle);                        /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                  /* check handle */
+    {
+        return 2;                                      /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))             /* check handle initialization */
+    {
+        return 3;                                      /* return error */
+    }
+    
+    *enable = (ds1307_bool_t)(handle->sqw);            /* get sqw */
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief     sqw edge irq handler
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 sqw discipline is disabled
+ * @note      call it on every falling edge of the 1Hz SQW/OUT signal,
+ *            it never touches the bus and is safe in an interrupt
+ */
+uint8_t ds1307_sqw_irq_handler(ds1307_handle_t *handle)
+{
+    uint64_t tick;
+    
+    DS1307_PROBE_ENTER(handle);                        /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                  /* check handle */
+    {
+        return 2;                                      /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))             /* check handle initialization */
+    {
+        return 3;                                      /* return error */
+    }
+    if (handle->sqw == 0)                              /* check sqw */
+    {
+        return 4;                                      /* return error */
+    }
+    
+    tick = handle->get_tick_ns();                      /* get tick */
+    handle->sqw_seq++;                                 /* begin the update */
+    DS1307_MEMORY_BARRIER();                           /* publish the odd sequence first */
+    handle->sqw_edge_tick = tick;                      /* save tick */
+    DS1307_MEMORY_BARRIER();                           /* publish the data first */
+    handle->sqw_seq++;                                 /* finish the update */
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the sqw disciplined time
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure
+ * @param[out] *ns pointer to a nanoseconds since the second started buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get sqw time failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 sqw discipline is disabled
+ *             - 5 sqw is not locked
+ * @note       the registers are only read to lock onto the edges
+ */
+uint8_t ds1307_get_sqw_time(ds1307_handle_t *handle, ds1307_time_t *t, uint32_t *ns)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t buf[7];
+    uint32_t edge;
+    uint32_t check;
+    uint32_t second;
+    uint32_t days;
+    uint64_t tick;
+    uint64_t elapsed;
+    
+    DS1307_PROBE_ENTER(handle);                                                                /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                          /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                                     /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_GET_TIME);                                                /* api entry */
+    if (DS1307_CHECK((t == NULL) || (ns == NULL)))                                             /* check time */
+    {
+        DS1307_LOG(handle, DS1307_LOG_TIME_IS_NULL, 0);                                        /* time is null */
+        
+        return 2;                                                                              /* return error */
+    }
+    if (handle->sqw == 0)                                                                      /* check sqw */
+    {
+        DS1307_LOG(handle, DS1307_LOG_SQW_DISCIPLINE_IS_DISABLED, 0);                          /* sqw discipline is disabled */
+        
+        return 4;                                                                              /* return error */
+    }
+    
+    for (i = 0; i < 2; i++)                                                                    /* try twice to lock */
+    {
+        a_ds1307_sqw_sample(handle, &edge, &tick);                                             /* sample the last edge */
+        if (edge == 0)                                                                         /* check edge */
+        {
+            DS1307_LOG(handle, DS1307_LOG_NO_SQW_EDGE, 0);                                     /* no sqw edge */
+            
+            return 5;                                                                          /* return error */
+        }
+        elapsed = handle->get_tick_ns() - tick;                                                /* time since the edge */
+        if (elapsed >= DS1307_SQW_TIMEOUT_NS)                                                  /* check timeout */
+        {
+            handle->sqw_anchor_valid = 0;                                                      /* drop anchor */
+            DS1307_LOG(handle, DS1307_LOG_SQW_EDGE_IS_LOST, 0);                                /* sqw edge is lost */
+            
+            return 5;                                                                          /* return error */
+        }
+        if (handle->sqw_anchor_valid != 0)                                                     /* check anchor */
+        {
+            break;                                                                             /* locked */
+        }
+        res = a_ds1307_bus_read(handle, &api, DS1307_REG_SECOND, (uint8_t *)buf, 7);           /* read time, never from a snapshot */
+        if (res != 0)                                                                          /* check result */
+        {
+            DS1307_LOG(handle, DS1307_LOG_MULTIPLE_READ_FAILED, 0);                            /* multiple read failed */
+            
+            return 1;                                                                          /* return error */
+        }
+        a_ds1307_sqw_sample(handle, &check, &tick);                                            /* sample again */
+        if (check != edge)                                                                     /* an edge hit the read */
+        {
+            DS1307_STATS_RETRY(handle, api.op);                                                /* count retry */
+            
+            continue;                                                                          /* try again */
+        }
+        a_ds1307_time_decode(buf, t);                                                          /* decode time */
+        if (((buf[0] >> 7) != 0) || (a_ds1307_time_check(t) != 0))                             /* check time */
+        {
+            DS1307_LOG(handle, DS1307_LOG_TIME_IS_INVALID, 0);                                 /* time is invalid */
+            
+            return 1;                                                                          /* return error */
+        }
+        handle->sqw_anchor_second = a_ds1307_time_to_second(t);                                /* save anchor */
+        handle->sqw_anchor_week = t->week;                                                     /* save week */
+        handle->sqw_anchor_format = (uint8_t)(t->format);                                      /* save format */
+        handle->sqw_anchor_edge = edge;                                                        /* save edge */
+        handle->sqw_anchor_valid = 1;                                                          /* flag valid */
+        break;                                                                                 /* locked */
+    }
+    if (handle->sqw_anchor_valid == 0)                                                         /* check lock */
+    {
+        DS1307_LOG(handle, DS1307_LOG_SQW_IS_NOT_LOCKED, 0);                                   /* sqw is not locked */
+        
+        return 5;                                                                              /* return error */
+    }
+    
+    elapsed = handle->get_tick_ns() - tick;                                                    /* time since the edge */
+    second = handle->sqw_anchor_second + (edge - handle->sqw_anchor_edge);                     /* count edges */
+    a_ds1307_second_to_time(second, (ds1307_format_t)(handle->sqw_anchor_format), t);          /* convert */
+    days = second / 86400 - handle->sqw_anchor_second / 86400;                                 /* days since anchor */
+    t->week = (uint8_t)((handle->sqw_anchor_week - 1 + days) % 7 + 1);                         /* keep the chip's week */
+    *ns = (elapsed > 999999999ULL) ? 999999999UL : (uint32_t)elapsed;                          /* set sub second */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the register cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the cache shadows the control register and the clock halt bit,
+ *            it is filled on first access and the content is dropped on every call
+ */
+uint8_t ds1307_set_register_cache(ds1307_handle_t *handle, ds1307_bool_t enable)
+{
+    DS1307_PROBE_ENTER(handle);                  /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))            /* check handle */
+    {
+        return 2;                                /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))       /* check handle initialization */
+    {
+        return 3;                                /* return error */
+    }
+    
+    handle->reg_cache = (uint8_t)enable;         /* set cache */
+    handle->reg_cache_valid = 0;                 /* drop cache */
+    
+    return 0;                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the register cache status
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_register_cache(ds1307_handle_t *handle, ds1307_bool_t *enable)
+{
+    DS1307_PROBE_ENTER(handle);                              /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                        /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                   /* check handle initialization */
+    {
+        return 3;                                            /* return error */
+    }
+    
+    *enable = (ds1307_bool_t)(handle->reg_cache);            /* get cache */
+    
+    return 0;                                                /* success return 0 */
+}
+
+/**
+ * @brief     invalidate the register cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it when another bus master may have changed the chip,
+ *            the next access reads the registers again
+ */
+uint8_t ds1307_invalidate_register_cache(ds1307_handle_t *handle)
+{
+    DS1307_PROBE_ENTER(handle);             /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))       /* check handle */
+    {
+        return 2;                           /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))  /* check handle initialization */
+    {
+        return 3;                           /* return error */
+    }
+    
+    handle->reg_cache_valid = 0;            /* drop cache */
+    
+    return 0;                               /* success return 0 */
+}
+
+/**
+ * @brief     refresh the register cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh register cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 register cache is disabled
+ * @note      none
+ */
+uint8_t ds1307_refresh_register_cache(ds1307_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t buf[8];
+    
+    DS1307_PROBE_ENTER(handle);                                                  /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                            /* check handle */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                       /* check handle initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_READ_CONTROL);                              /* api entry */
+    if (handle->reg_cache == 0)                                                  /* check cache */
+    {
+        DS1307_LOG(handle, DS1307_LOG_REGISTER_CACHE_IS_DISABLED, 0);            /* register cache is disabled */
+        
+        return 4;                                                                /* return error */
+    }
+    
+    handle->reg_cache_valid = 0;                                                 /* drop cache */
+    res = a_ds1307_bus_read(handle, &api, DS1307_REG_SECOND, buf, 8);            /* read second to control */
+    if (res != 0)                                                                /* check result */
+    {
+        DS1307_LOG(handle, DS1307_LOG_MULTIPLE_READ_FAILED, 0);                  /* multiple read failed */
+        
+        return 1;                                                                /* return error */
+    }
+    a_ds1307_reg_cache_second(handle, buf[0]);                                   /* update ch */
+    handle->control = buf[7];                                                    /* save control */
+    handle->reg_cache_valid |= DS1307_REG_CACHE_CONTROL;                         /* flag valid */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+#if (DS1307_CONFIG_STATS != 0)
+/**
+ * @brief      get the bus stats
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or stats is NULL
+ *             - 3 handle is not initialized
+ * @note       the copy is taken under the bus lock, latencies are in ticks of the linked stats_tick
+ *             and the histograms stay empty when it is not linked
+ */
+uint8_t ds1307_get_stats(ds1307_handle_t *handle, ds1307_stats_t *stats)
+{
+    DS1307_PROBE_ENTER(handle);                                     /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                               /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                          /* check handle initialization */
+    {
+        return 3;                                                   /* return error */
+    }
+    if (DS1307_CHECK(stats == NULL))                                /* check stats */
+    {
+        DS1307_LOG(handle, DS1307_LOG_STATS_IS_NULL, 0);            /* stats is null */
+        
+        return 2;                                                   /* return error */
+    }
+    
+    a_ds1307_lock(handle);                                          /* lock */
+    memcpy(stats, &handle->stats, sizeof(ds1307_stats_t));          /* copy stats */
+    a_ds1307_unlock(handle);                                        /* unlock */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief     reset the bus stats
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      ds1307_init resets them too
+ */
+uint8_t ds1307_reset_stats(ds1307_handle_t *handle)
+{
+    DS1307_PROBE_ENTER(handle);                                     /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                               /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                          /* check handle initialization */
+    {
+        return 3;                                                   /* return error */
+    }
+    
+    a_ds1307_lock(handle);                                          /* lock */
+    memset(&handle->stats, 0, sizeof(ds1307_stats_t));              /* clear stats */
+    a_ds1307_unlock(handle);                                        /* unlock */
+    
+    return 0;                                                       /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     log a message
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] id message id
+ * @param[in] arg numeric argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 id is invalid
+ * @note      the text goes to debug_print and the id and the argument go to the linked log ring,
+ *            recording is lock free and safe from interrupts, the handle needs no init
+ */
+uint8_t ds1307_log(ds1307_handle_t *handle, ds1307_log_t id, uint16_t arg)
+{
+#if (DS1307_CONFIG_LOG_BINARY != 0)
+    uint32_t seq;
+    ds1307_log_entry_t *entry;
+#endif
+    
+    DS1307_PROBE_ENTER(handle);                                                         /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                   /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (DS1307_CHECK((id == 0) || (id >= DS1307_LOG_MAX)))                              /* check id */
+    {
+        return 4;                                                                       /* return error */
+    }
+    
+#if (DS1307_CONFIG_LOG_TEXT != 0)
+    if (handle->debug_print != NULL)                                                    /* check debug_print */
+    {
+        handle->debug_print(gs_log_text[id]);                                           /* print the text */
+    }
+#endif
+#if (DS1307_CONFIG_LOG_BINARY != 0)
+    if ((handle->log_buf != NULL) && (handle->log_num != 0) &&
+        ((handle->log_num & (handle->log_num - 1)) == 0))                               /* check log ring */
+    {
+        seq = DS1307_ATOMIC_FETCH_INC(&handle->log_head) + 1;                           /* claim an entry */
+        entry = &handle->log_buf[(seq - 1) & (handle->log_num - 1)];                    /* get entry */
+        entry->seq = 0;                                                                 /* flag the entry busy */
+        DS1307_MEMORY_BARRIER();                                                        /* publish busy first */
+        entry->tick = (handle->get_tick_ns != NULL) ?
+                      (uint32_t)(handle->get_tick_ns() / 1000) : 0;                     /* set tick in us */
+        entry->id = (uint16_t)id;                                                       /* set id */
+        entry->arg = arg;                                                               /* set argument */
+        DS1307_MEMORY_BARRIER();                                                        /* publish the data first */
+        entry->seq = seq;                                                               /* flag the entry done */
+    }
+#endif
+    (void)arg;                                                                          /* unused without the ring */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+#if (DS1307_CONFIG_LOG_BINARY != 0)
+/**
+ * @brief         read the log ring
+ * @param[in]     *handle pointer to a ds1307 handle structure
+ * @param[out]    *entry pointer to a log entry buffer
+ * @param[in,out] *len pointer to a length buffer
+ * @param[out]    *lost pointer to a lost entry number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle, entry, len or lost is NULL
+ *                - 4 log ring is not linked
+ * @note          returns the oldest unread entries, *lost counts the entries overwritten before they were read,
+ *                one reader at a time, the handle needs no init
+ */
+uint8_t ds1307_log_read(ds1307_handle_t *handle, ds1307_log_entry_t *entry, uint32_t *len, uint32_t *lost)
 {
-    if (handle->iic_write(DS1307_ADDRESS, reg, &data, 1) != 0)        /* write data */
+    uint32_t head;
+    uint32_t tail;
+    uint32_t num;
+    ds1307_log_entry_t copy;
+    
+    DS1307_PROBE_ENTER(handle);                                                         /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                   /* check handle */
     {
-        return 1;                                                     /* return error */
+        return 2;                                                                       /* return error */
     }
-    else
+    if (DS1307_CHECK((entry == NULL) || (len == NULL) || (lost == NULL)))               /* check entry, len and lost */
     {
-        return 0;                                                     /* success return 0 */
+        DS1307_LOG(handle, DS1307_LOG_BUF_IS_NULL, 0);                                  /* buf is null */
+        
+        return 2;                                                                       /* return error */
+    }
+    if ((handle->log_buf == NULL) || (handle->log_num == 0) ||
+        ((handle->log_num & (handle->log_num - 1)) != 0))                               /* check log ring */
+    {
+        DS1307_LOG(handle, DS1307_LOG_LOG_BUFFER_IS_NOT_LINKED, 0);                     /* log buffer is not linked */
+        
+        return 4;                                                                       /* return error */
+    }
+    
+    num = 0;                                                                            /* init 0 */
+    *lost = 0;                                                                          /* init 0 */
+    tail = handle->log_tail;                                                            /* get tail */
+    head = handle->log_head;                                                            /* get head */
+    DS1307_MEMORY_BARRIER();                                                            /* read the head first */
+    if ((head - tail) > handle->log_num)                                                /* check overrun */
+    {
+        *lost += head - tail - handle->log_num;                                         /* count the overwritten entries */
+        tail = head - handle->log_num;                                                  /* skip them */
+    }
+    while ((tail != head) && (num < *len))                                              /* read every finished entry */
+    {
+        copy = handle->log_buf[tail & (handle->log_num - 1)];                           /* copy the entry */
+        DS1307_MEMORY_BARRIER();                                                        /* copy before the check */
+        if ((copy.seq == tail + 1) &&
+            (handle->log_buf[tail & (handle->log_num - 1)].seq == copy.seq))            /* check the entry is stable */
+        {
+            entry[num] = copy;                                                          /* save the entry */
+            num++;                                                                      /* next entry */
+            tail++;                                                                     /* next tail */
+        }
+        else if ((int32_t)(copy.seq - (tail + 1)) > 0)                                  /* check overwritten */
+        {
+            (*lost)++;                                                                  /* count the entry */
+            tail++;                                                                     /* next tail */
+        }
+        else                                                                            /* still written */
+        {
+            break;                                                                      /* break */
+        }
     }
+    handle->log_tail = tail;                                                            /* save tail */
+    *len = num;                                                                         /* save length */
+    
+    return 0;                                                                           /* success return 0 */
 }
+#endif
 
+#if (DS1307_CONFIG_LOG_TEXT != 0)
 /**
- * @brief     write multiple bytes
- * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] reg iic register address
- * @param[in] *buf pointer to a data buffer
- * @param[in] len data buffer length
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- * @note      none
+ * @brief      get the text of a message
+ * @param[in]  id message id
+ * @param[out] **text pointer to a text pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 text is NULL
+ *             - 4 id is invalid
+ * @note       decodes the ids of a log ring dump
  */
-static uint8_t a_ds1307_iic_multiple_write(ds1307_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+uint8_t ds1307_log_get_text(uint16_t id, const char **text)
 {
-    if (handle->iic_write(DS1307_ADDRESS, reg, buf, len) != 0)       /* write data */
+    DS1307_PROBE_ENTER(NULL);                                    /* probe entry and exit */
+    if (text == NULL)                                            /* check text */
     {
-        return 1;                                                    /* return error */
+        return 2;                                                /* return error */
     }
-    else
-    {                                                                /* success return 0 */
-        return 0;
+    if ((id == 0) || (id >= DS1307_LOG_MAX))                     /* check id */
+    {
+        return 4;                                                /* return error */
     }
+    
+    *text = gs_log_text[id];                                     /* get text */
+    
+    return 0;                                                    /* success return 0 */
 }
+#endif
 
 /**
- * @brief      read multiple bytes
+ * @brief      capture all 64 registers
  * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[in]  reg iic register address
- * @param[out] *buf pointer to a data buffer
- * @param[in]  len data buffer length
+ * @param[out] *snapshot pointer to a snapshot structure
  * @return     status code
  *             - 0 success
- *             - 1 read failed
- * @note       none
+ *             - 1 snapshot failed
+ *             - 2 handle or snapshot is NULL
+ *             - 3 handle is not initialized
+ * @note       the chip is always read in one burst, even while a snapshot is bound,
+ *             and the ram mirror bytes replace the ram registers when the ram cache is enabled
  */
-static uint8_t a_ds1307_iic_multiple_read(ds1307_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+uint8_t ds1307_snapshot(ds1307_handle_t *handle, ds1307_snapshot_t *snapshot)
 {
-    if (handle->iic_read(DS1307_ADDRESS, reg, buf, len) != 0)        /* read data */
+    DS1307_PROBE_ENTER(handle);                                                                   /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                             /* check handle */
     {
-        return 1;                                                    /* return error */
+        return 2;                                                                                 /* return error */
     }
-    else
-    {                                                                /* success return 0 */
-        return 0;
+    if (DS1307_CHECK(handle->inited != 1))                                                        /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    DS1307_API_ENTER(DS1307_STATS_OP_SNAPSHOT);                                                   /* api entry */
+    if (DS1307_CHECK(snapshot == NULL))                                                           /* check snapshot */
+    {
+        DS1307_LOG(handle, DS1307_LOG_SNAPSHOT_IS_NULL, 0);                                       /* snapshot is null */
+        
+        return 2;                                                                                 /* return error */
+    }
+    
+    if (a_ds1307_bus_read(handle, &api, DS1307_REG_SECOND, snapshot->reg, 64) != 0)               /* read all registers */
+    {
+        DS1307_LOG(handle, DS1307_LOG_SNAPSHOT_FAILED, 0);                                        /* snapshot failed */
+        
+        return 1;                                                                                 /* return error */
+    }
+    if (handle->ram_cache != DS1307_RAM_CACHE_DISABLE)                                            /* check ram cache */
+    {
+        memcpy(&snapshot->reg[DS1307_REG_RAM], handle->ram, 56);                                  /* overlay the mirror */
+    }
+    a_ds1307_reg_cache_second(handle, snapshot->reg[DS1307_REG_SECOND]);                          /* update ch */
+    if (handle->reg_cache != 0)                                                                   /* check cache */
+    {
+        handle->control = snapshot->reg[DS1307_REG_CONTROL];                                      /* save control */
+        handle->reg_cache_valid |= DS1307_REG_CACHE_CONTROL;                                      /* flag valid */
     }
+    
+    return 0;                                                                                     /* success return 0 */
 }
 
 /**
- * @brief     hex to bcd
- * @param[in] val hex data
- * @return    bcd data
- * @note      none
+ * @brief     bind a snapshot to the handle
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *snapshot pointer to a snapshot structure, NULL unbinds
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      while bound every driver read is served from the snapshot without bus traffic,
+ *            writes still go to the chip and update the snapshot, the time cache is bypassed,
+ *            read-modify-write setters still read the chip and never fill a cache from the snapshot
  */
-static uint8_t a_ds1307_hex2bcd(uint8_t val)
+uint8_t ds1307_bind_snapshot(ds1307_handle_t *handle, ds1307_snapshot_t *snapshot)
 {
-    uint8_t i, j, k;
+    DS1307_PROBE_ENTER(handle);                         /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                   /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))              /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
     
-    i = val / 10;            /* get tens place */
-    j = val % 10;            /* get ones place */
-    k = j + (i << 4);        /* set bcd */
+    handle->snapshot = snapshot;                        /* set snapshot */
     
-    return k;                /* return bcd */
+    return 0;                                           /* success return 0 */
 }
 
 /**
- * @brief     bcd to hex
- * @param[in] val bcd data
- * @return    hex data
- * @note      none
+ * @brief      start reading the current time
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure, valid when the callback reports 0
+ * @param[in]  callback completion callback
+ * @param[in]  *arg callback argument
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async operation is busy
+ *             - 5 async transport is not linked
+ * @note       always reads the chip, the time is published like ds1307_get_time
  */
-static uint8_t a_ds1307_bcd2hex(uint8_t val)
+uint8_t ds1307_get_time_async(ds1307_handle_t *handle, ds1307_time_t *t, ds1307_async_callback_t callback, void *arg)
 {
-    uint8_t temp;
+    uint8_t res;
+    
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(t == NULL))                                                         /* check time */
+    {
+        DS1307_LOG(handle, DS1307_LOG_TIME_IS_NULL, 0);                                  /* time is null */
+        
+        return 2;                                                                        /* return error */
+    }
     
-    temp = val & 0x0F;              /* get ones place */
-    val = (val >> 4) & 0x0F;        /* get tens place */
-    val = val * 10;                 /* set tens place */
-    temp = temp + val;              /* get hex */
+    res = a_ds1307_async_check(handle);                                                  /* check async */
+    if (res != 0)                                                                        /* check result */
+    {
+        return res;                                                                      /* return error */
+    }
+    handle->async_time_out = t;                                                          /* save destination */
+    handle->async_tick = 0;                                                              /* init 0 */
+    if (handle->time_cache != 0)                                                         /* check time cache */
+    {
+        handle->async_tick = handle->get_tick_ns();                                      /* get tick */
+    }
     
-    return temp;                    /* return hex */
+    return a_ds1307_async_start(handle, DS1307_ASYNC_GET_TIME, DS1307_REG_SECOND, 7,
+                                callback, arg);                                          /* read the time registers */
 }
 
 /**
- * @brief     set the current time
+ * @brief     start writing the current time
  * @param[in] *handle pointer to a ds1307 handle structure
  * @param[in] *t pointer to a time structure
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
  * @return    status code
  *            - 0 success
- *            - 1 set time failed
+ *            - 1 start failed
  *            - 2 handle or time is NULL
  *            - 3 handle is not initialized
- *            - 4 time is invalid
- * @note      none
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ *            - 6 time is invalid
+ * @note      the second register is read first to keep the clock halt bit,
+ *            the time is copied so *t may go out of scope
  */
-uint8_t ds1307_set_time(ds1307_handle_t *handle, ds1307_time_t *t)
+uint8_t ds1307_set_time_async(ds1307_handle_t *handle, ds1307_time_t *t, ds1307_async_callback_t callback, void *arg)
 {
     uint8_t res;
-    uint8_t reg;
-    uint16_t year;
     
-    if (handle == NULL)                                                                                      /* check handle */
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
     {
-        return 2;                                                                                            /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                                                 /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
     {
-        return 3;                                                                                            /* return error */
+        return 3;                                                                        /* return error */
     }
-    if (t == NULL)                                                                                           /* check time */
+    if (DS1307_CHECK(t == NULL))                                                         /* check time */
     {
-        handle->debug_print("ds1307: time is null.\n");                                                      /* time is null */
+        DS1307_LOG(handle, DS1307_LOG_TIME_IS_NULL, 0);                                  /* time is null */
         
-        return 2;                                                                                            /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (t->format == DS1307_FORMAT_12H)                                                                      /* if 12H */
+    
+    res = a_ds1307_async_check(handle);                                                  /* check async */
+    if (res != 0)                                                                        /* check result */
     {
-        if ((t->year < 2000) || (t->year > 2100))                                                            /* check year */
-        {
-            handle->debug_print("ds1307: year can't be over 2100 or less than 2000.\n");                     /* year can't be over 2100 or less than 2000 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->month == 0) || (t->month > 12))                                                              /* check month */
-        {
-            handle->debug_print("ds1307: month can't be zero or over than 12.\n");                           /* month can't be zero or over than 12 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->week == 0) || (t->week > 7))                                                                 /* check week */
-        {
-            handle->debug_print("ds1307: week can't be zero or over than 7.\n");                             /* week can't be zero or over than 7 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->date == 0) || (t->date > 31))                                                                /* check data */
-        {
-            handle->debug_print("ds1307: date can't be zero or over than 31.\n");                            /* date can't be zero or over than 31 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->hour < 1) || (t->hour > 12))                                                                 /* check hour */
-        {
-            handle->debug_print("ds1307: hour can't be over than 12 or less 1.\n");                          /* hour can't be over than 12 or less 1 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->minute > 59)                                                                                  /* check minute */
-        {
-            handle->debug_print("ds1307: minute can't be over than 59.\n");                                  /* minute can't be over than 59 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->second > 59)                                                                                  /* check second */
-        {
-            handle->debug_print("ds1307: second can't be over than 59.\n");                                  /* second can't be over than 59 */
-            
-            return 4;                                                                                        /* return error */
-        }
+        return res;                                                                      /* return error */
     }
-    else if (t->format == DS1307_FORMAT_24H)                                                                 /* if 24H */
+    if (DS1307_CHECK(a_ds1307_time_check_print(handle, t) != 0))                         /* check time */
     {
-        if ((t->year < 2000) || (t->year > 2100))                                                            /* check year */
-        {
-            handle->debug_print("ds1307: year can't be over 2100 or less than 2000.\n");                     /* year can't be over 2100 or less than 2000 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->month == 0) || (t->month > 12))                                                              /* check month */
-        {
-            handle->debug_print("ds1307: month can't be zero or over than 12.\n");                           /* month can't be zero or over than 12 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->week == 0) || (t->week > 7))                                                                 /* check week */
-        {
-            handle->debug_print("ds1307: week can't be zero or over than 7.\n");                             /* week can't be zero or over than 7 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->date == 0) || (t->date > 31))                                                                /* check data */
-        {
-            handle->debug_print("ds1307: date can't be zero or over than 31.\n");                            /* date can't be zero or over than 31 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->hour > 23)                                                                                    /* check hour */
-        {
-            handle->debug_print("ds1307: hour can't be over than 23.\n");                                    /* hour can't be over than 23 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->minute > 59)                                                                                  /* check minute */
-        {
-            handle->debug_print("ds1307: minute can't be over than 59.\n");                                  /* minute can't be over than 59 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->second > 59)                                                                                  /* check second */
-        {
-            handle->debug_print("ds1307: second can't be over than 59.\n");                                  /* second can't be over than 59 */
-            
-            return 4;                                                                                        /* return error */
-        }
+        return 6;                                                                        /* return error */
     }
-    else
+    handle->async_time = *t;                                                             /* copy time */
+    a_ds1307_reg_cache_drop(handle, DS1307_REG_SECOND, 7);                               /* drop cache */
+    
+    return a_ds1307_async_start(handle, DS1307_ASYNC_SET_TIME, DS1307_REG_SECOND, 1,
+                                callback, arg);                                          /* read the second register */
+}
+
+/**
+ * @brief      start reading ram
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[in]  addr ram address
+ * @param[out] *buf pointer to a data buffer, valid when the callback reports 0
+ * @param[in]  len buffer length
+ * @param[in]  callback completion callback
+ * @param[in]  *arg callback argument
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ *             - 2 handle or buf is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async operation is busy
+ *             - 5 async transport is not linked
+ *             - 6 addr > 55
+ *             - 7 len is invalid
+ * @note       served from the ram mirror when the ram cache is enabled,
+ *             the callback then runs before this function returns
+ */
+uint8_t ds1307_read_ram_async(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len,
+                              ds1307_async_callback_t callback, void *arg)
+{
+    uint8_t res;
+    
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(buf == NULL))                                                       /* check buf */
     {
-        handle->debug_print("ds1307: format is invalid.\n");                                                 /* format is invalid */
+        DS1307_LOG(handle, DS1307_LOG_BUF_IS_NULL, 0);                                   /* buf is null */
         
-        return 4;                                                                                            /* return error */
+        return 2;                                                                        /* return error */
     }
     
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_SECOND, &reg, 1);                                    /* read second */
-    if (res != 0)                                                                                            /* check result */
+    res = a_ds1307_async_check(handle);                                                  /* check async */
+    if (res != 0)                                                                        /* check result */
+    {
+        return res;                                                                      /* return error */
+    }
+    if (DS1307_CHECK(addr > 55))                                                         /* check addr */
     {
-        handle->debug_print("ds1307: read second failed.\n");                                                /* read second failed */
+        DS1307_LOG(handle, DS1307_LOG_ADDR_IS_INVALID, addr);                            /* addr > 55 */
         
-        return 1;                                                                                            /* return error */
+        return 6;                                                                        /* return error */
     }
-    res = a_ds1307_iic_write(handle, DS1307_REG_SECOND, a_ds1307_hex2bcd(t->second) | (reg & (1 << 7)));     /* write second */
-    if (res != 0)                                                                                            /* check result */
+    if (DS1307_CHECK(addr + len - 1 > 55))                                               /* check len */
     {
-        handle->debug_print("ds1307: write second failed.\n");                                               /* write second failed */
+        DS1307_LOG(handle, DS1307_LOG_LEN_IS_INVALID, len);                              /* len is invalid */
         
-        return 1;                                                                                            /* return error */
+        return 7;                                                                        /* return error */
     }
-    res = a_ds1307_iic_write(handle, DS1307_REG_MINUTE, a_ds1307_hex2bcd(t->minute));                        /* write minute */
-    if (res != 0)                                                                                            /* check result */
+    
+    if (handle->ram_cache != DS1307_RAM_CACHE_DISABLE)                                   /* check ram cache */
     {
-        handle->debug_print("ds1307: write minute failed.\n");                                               /* write minute failed */
+        memcpy(buf, &handle->ram[addr], len);                                            /* read the mirror */
+        if (callback != NULL)                                                            /* check callback */
+        {
+            callback(handle, 0, arg);                                                    /* run callback */
+        }
         
-        return 1;                                                                                            /* return error */
+        return 0;                                                                        /* success return 0 */
     }
-    if (t->format == DS1307_FORMAT_12H)                                                                      /* if 12H */
+    handle->async_out = buf;                                                             /* save destination */
+    
+    return a_ds1307_async_start(handle, DS1307_ASYNC_READ, (uint8_t)(DS1307_REG_RAM + addr), len,
+                                callback, arg);                                          /* read ram */
+}
+
+/**
+ * @brief     start writing ram
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] addr ram address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle or buf is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ *            - 6 addr > 55
+ *            - 7 len is invalid
+ * @note      the data is copied, in write back mode only the ram mirror is written
+ *            and the callback runs before this function returns
+ */
+uint8_t ds1307_write_ram_async(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len,
+                               ds1307_async_callback_t callback, void *arg)
+{
+    uint8_t res;
+    
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
     {
-        reg = (uint8_t)((1 << 6) | (t->am_pm << 5) | a_ds1307_hex2bcd(t->hour));                             /* set hour in 12H */
+        return 2;                                                                        /* return error */
     }
-    else                                                                                                     /* if 24H */
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
     {
-        reg = (0 << 6) | a_ds1307_hex2bcd(t->hour);                                                          /* set hour in 24H */
+        return 3;                                                                        /* return error */
     }
-    res = a_ds1307_iic_write(handle, DS1307_REG_HOUR, reg);                                                  /* write hour */
-    if (res != 0)                                                                                            /* check result */
+    if (DS1307_CHECK(buf == NULL))                                                       /* check buf */
     {
-        handle->debug_print("ds1307: write hour failed.\n");                                                 /* write hour failed */
+        DS1307_LOG(handle, DS1307_LOG_BUF_IS_NULL, 0);                                   /* buf is null */
         
-        return 1;                                                                                            /* return error */
+        return 2;                                                                        /* return error */
     }
-    res = a_ds1307_iic_write(handle, DS1307_REG_WEEK, a_ds1307_hex2bcd(t->week));                            /* write week */
-    if (res != 0)                                                                                            /* check result */
+    
+    res = a_ds1307_async_check(handle);                                                  /* check async */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("ds1307: write week failed.\n");                                                 /* write week failed */
-        
-        return 1;                                                                                            /* return error */
+        return res;                                                                      /* return error */
     }
-    res = a_ds1307_iic_write(handle, DS1307_REG_DATE, a_ds1307_hex2bcd(t->date));                            /* write data */
-    if (res != 0)                                                                                            /* check result */
+    if (DS1307_CHECK(addr > 55))                                                         /* check addr */
     {
-        handle->debug_print("ds1307: write date failed.\n");                                                 /* write date failed */
+        DS1307_LOG(handle, DS1307_LOG_ADDR_IS_INVALID, addr);                            /* addr > 55 */
         
-        return 1;                                                                                            /* return error */
+        return 6;                                                                        /* return error */
     }
-    res = a_ds1307_iic_write(handle, DS1307_REG_MONTH, a_ds1307_hex2bcd(t->month));                          /* write month and century */
-    if (res != 0)                                                                                            /* check result */
+    if (DS1307_CHECK(addr + len - 1 > 55))                                               /* check len */
     {
-        handle->debug_print("ds1307: write century and month failed.\n");                                    /* write century and month failed */
+        DS1307_LOG(handle, DS1307_LOG_LEN_IS_INVALID, len);                              /* len is invalid */
         
-        return 1;                                                                                            /* return error */
+        return 7;                                                                        /* return error */
     }
-    year = t->year - 2000;                                                                                   /* year - 2000 */
-    res = a_ds1307_iic_write(handle, DS1307_REG_YEAR, a_ds1307_hex2bcd((uint8_t)year));                      /* write year */
-    if (res != 0)                                                                                            /* check result */
+    
+    if (handle->ram_cache == DS1307_RAM_CACHE_WRITE_BACK)                                /* check write back */
     {
-        handle->debug_print("ds1307: write year failed.\n");                                                 /* write year failed */
+        memcpy(&handle->ram[addr], buf, len);                                            /* write the mirror */
+        handle->ram_dirty |= a_ds1307_ram_mask(addr, len);                               /* flag dirty */
+        if (callback != NULL)                                                            /* check callback */
+        {
+            callback(handle, 0, arg);                                                    /* run callback */
+        }
         
-        return 1;                                                                                            /* return error */
+        return 0;                                                                        /* success return 0 */
     }
+    memcpy(handle->async_buf, buf, len);                                                 /* copy data */
     
-    return 0;                                                                                                /* success return 0 */
+    return a_ds1307_async_start(handle, DS1307_ASYNC_WRITE, (uint8_t)(DS1307_REG_RAM + addr), len,
+                                callback, arg);                                          /* write ram */
 }
 
 /**
- * @brief      get the current time
- * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[out] *t pointer to a time structure
- * @return     status code
- *             - 0 success
- *             - 1 get time failed
- *             - 2 handle or time is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     start enabling or disabling the oscillator
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ * @note      the register is read, modified and written in two transfers
  */
-uint8_t ds1307_get_time(ds1307_handle_t *handle, ds1307_time_t *t)
+uint8_t ds1307_set_oscillator_async(ds1307_handle_t *handle, ds1307_bool_t enable, ds1307_async_callback_t callback, void *arg)
 {
     uint8_t res;
-    uint8_t buf[7];
     
-    if (handle == NULL)                                                                   /* check handle */
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                        /* return error */
     }
-    if (t == NULL)                                                                        /* check time */
+    
+    res = a_ds1307_async_check(handle);                                                  /* check async */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("ds1307: time is null.\n");                                   /* time is null */
-        
-        return 2;                                                                         /* return error */
+        return res;                                                                      /* return error */
+    }
+    handle->async_mask = 1 << 7;                                                         /* set mask */
+    handle->async_value = (uint8_t)((!enable) << 7);                                     /* set value */
+    a_ds1307_reg_cache_drop(handle, DS1307_REG_SECOND, 1);                               /* drop cache */
+    
+    return a_ds1307_async_start(handle, DS1307_ASYNC_UPDATE, DS1307_REG_SECOND, 1,
+                                callback, arg);                                          /* read the register */
+}
+
+/**
+ * @brief     start setting the output level
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] level output level
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ * @note      the register is read, modified and written in two transfers
+ */
+uint8_t ds1307_set_output_level_async(ds1307_handle_t *handle, ds1307_output_level_t level, ds1307_async_callback_t callback, void *arg)
+{
+    uint8_t res;
+    
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    res = a_ds1307_async_check(handle);                                                  /* check async */
+    if (res != 0)                                                                        /* check result */
+    {
+        return res;                                                                      /* return error */
     }
+    handle->async_mask = 1 << 7;                                                         /* set mask */
+    handle->async_value = (uint8_t)(level << 7);                                         /* set value */
+    a_ds1307_reg_cache_drop(handle, DS1307_REG_CONTROL, 1);                              /* drop cache */
+    
+    return a_ds1307_async_start(handle, DS1307_ASYNC_UPDATE, DS1307_REG_CONTROL, 1,
+                                callback, arg);                                          /* read the register */
+}
+
+/**
+ * @brief     start setting the output mode
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] mode output mode
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ * @note      the register is read, modified and written in two transfers
+ */
+uint8_t ds1307_set_output_mode_async(ds1307_handle_t *handle, ds1307_output_mode_t mode, ds1307_async_callback_t callback, void *arg)
+{
+    uint8_t res;
     
-    memset(buf, 0, sizeof(uint8_t) * 7);                                                  /* clear the buffer */
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_SECOND, (uint8_t *)buf, 7);       /* multiple_read */
-    if (res != 0)                                                                         /* check result */
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
     {
-        handle->debug_print("ds1307: multiple read failed.\n");                           /* multiple read failed */
-        
-        return 1;                                                                         /* return error */
+        return 2;                                                                        /* return error */
     }
-    t->year = a_ds1307_bcd2hex(buf[6]) + 2000;                                            /* get year */
-    t->month = a_ds1307_bcd2hex(buf[5] & 0x1F);                                           /* get month */
-    t->week = a_ds1307_bcd2hex(buf[3] & 0x7);                                             /* get week */
-    t->date = a_ds1307_bcd2hex(buf[4] & 0x3F);                                            /* get date */
-    t->am_pm = (ds1307_am_pm_t)((buf[2] >> 5) & 0x01);                                    /* get am pm */
-    t->format = (ds1307_format_t)((buf[2] >> 6) & 0x01);                                  /* get format */
-    if (t->format == DS1307_FORMAT_12H)                                                   /* if 12H */
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
     {
-        t->hour = a_ds1307_bcd2hex(buf[2] & 0x1F);                                        /* get hour */
+        return 3;                                                                        /* return error */
     }
-    else
+    
+    res = a_ds1307_async_check(handle);                                                  /* check async */
+    if (res != 0)                                                                        /* check result */
     {
-        t->hour = a_ds1307_bcd2hex(buf[2] & 0x3F);                                        /* get hour */
+        return res;                                                                      /* return error */
     }
-    t->minute = a_ds1307_bcd2hex(buf[1]);                                                 /* get minute */
-    t->second = a_ds1307_bcd2hex(buf[0] & (~(1 << 7)));                                   /* get second */
+    handle->async_mask = 1 << 4;                                                         /* set mask */
+    handle->async_value = (uint8_t)(mode << 4);                                          /* set value */
+    a_ds1307_reg_cache_drop(handle, DS1307_REG_CONTROL, 1);                              /* drop cache */
     
-    return 0;                                                                             /* success return 0 */
+    return a_ds1307_async_start(handle, DS1307_ASYNC_UPDATE, DS1307_REG_CONTROL, 1,
+                                callback, arg);                                          /* read the register */
 }
 
 /**
- * @brief     enable or disable the oscillator
+ * @brief     start setting the square wave frequency
  * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] enable bool value
+ * @param[in] freq square wave frequency
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
  * @return    status code
  *            - 0 success
- *            - 1 set oscillator failed
+ *            - 1 start failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ * @note      the register is read, modified and written in two transfers
  */
-uint8_t ds1307_set_oscillator(ds1307_handle_t *handle, ds1307_bool_t enable)
+uint8_t ds1307_set_square_wave_frequency_async(ds1307_handle_t *handle, ds1307_square_wave_frequency_t freq, ds1307_async_callback_t callback, void *arg)
 {
     uint8_t res;
-    uint8_t prev;
     
-    if (handle == NULL)                                                           /* check handle */
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
     {
-        return 2;                                                                 /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                      /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
     {
-        return 3;                                                                 /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_SECOND, &prev, 1);        /* read second */
-    if (res != 0)                                                                 /* check result */
+    res = a_ds1307_async_check(handle);                                                  /* check async */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("ds1307: read second failed.\n");                     /* read second failed */
-        
-        return 1;                                                                 /* return error */
+        return res;                                                                      /* return error */
+    }
+    handle->async_mask = 3 << 0;                                                         /* set mask */
+    handle->async_value = (uint8_t)(freq << 0);                                          /* set value */
+    a_ds1307_reg_cache_drop(handle, DS1307_REG_CONTROL, 1);                              /* drop cache */
+    
+    return a_ds1307_async_start(handle, DS1307_ASYNC_UPDATE, DS1307_REG_CONTROL, 1,
+                                callback, arg);                                          /* read the register */
+}
+
+/**
+ * @brief     complete the async transfer in flight
+ * @param[in] *handle pointer to a ds1307 handle structure, the token given to the transport
+ * @param[in] res transfer result, 0 means success
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 no async operation is in flight
+ * @note      called by the transport from its completion context, it may start the
+ *            next transfer or run the operation callback
+ */
+uint8_t ds1307_async_complete(ds1307_handle_t *handle, uint8_t res)
+{
+    DS1307_PROBE_ENTER(handle);                                                                  /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                            /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->async_op == DS1307_ASYNC_IDLE)                                                   /* check operation */
+    {
+        return 3;                                                                                /* return error */
     }
-    prev &= ~(1 << 7);                                                            /* clear config */
-    prev |= (!enable) << 7;                                                       /* set enable */
-    res = a_ds1307_iic_write(handle, DS1307_REG_SECOND, prev);                    /* write second */
-    if (res != 0)                                                                 /* check result */
+    
+    DS1307_STATS_ASYNC_LATENCY(handle, res);                                                     /* count latency */
+    if (res != 0)                                                                                /* check result */
     {
-        handle->debug_print("ds1307: write second failed.\n");                    /* write second failed */
+        a_ds1307_reg_cache_drop(handle, handle->async_reg, handle->async_len);                   /* drop cache */
+        a_ds1307_async_finish(handle, 1);                                                        /* finish with error */
         
-        return 1;                                                                 /* return error */
+        return 0;                                                                                /* success return 0 */
+    }
+    switch (handle->async_op)
+    {
+        case DS1307_ASYNC_GET_TIME :
+        {
+            a_ds1307_reg_cache_second(handle, handle->async_buf[0]);                             /* update ch */
+            a_ds1307_time_decode(handle->async_buf, handle->async_time_out);                     /* decode time */
+            if (handle->time_cache != 0)                                                         /* check time cache */
+            {
+                a_ds1307_time_cache_update(handle, handle->async_time_out,
+                                           (handle->async_buf[0] >> 7) & 0x01,
+                                           handle->async_tick);                                  /* update time cache */
+            }
+            a_ds1307_time_publish(handle, handle->async_time_out);                               /* publish time */
+            a_ds1307_async_finish(handle, 0);                                                    /* finish */
+            
+            break;
+        }
+        case DS1307_ASYNC_SET_TIME :
+        {
+            if (handle->async_step == 0)                                                         /* second register read */
+            {
+                a_ds1307_time_encode(&handle->async_time, (handle->async_buf[7] >> 7) & 0x01,
+                                     handle->async_buf);                                         /* encode time */
+                handle->async_step = 1;                                                          /* next step */
+                handle->async_len = 7;                                                           /* 7 registers */
+                if (a_ds1307_async_transfer(handle, 0, DS1307_REG_SECOND,
+                                            handle->async_buf, 7) != 0)                          /* write time */
+                {
+                    a_ds1307_async_finish(handle, 1);                                            /* finish with error */
+                }
+            }
+            else
+            {
+                handle->time_cache_valid = 0;                                                    /* drop time cache */
+                handle->sqw_anchor_valid = 0;                                                    /* drop sqw anchor */
+                a_ds1307_bus_written(handle, DS1307_REG_SECOND, handle->async_buf, 7);           /* update state */
+                a_ds1307_time_publish(handle, &handle->async_time);                              /* publish time */
+                a_ds1307_async_finish(handle, 0);                                                /* finish */
+            }
+            
+            break;
+        }
+        case DS1307_ASYNC_UPDATE :
+        {
+            if (handle->async_step == 0)                                                         /* register read */
+            {
+                handle->async_buf[0] &= (uint8_t)(~handle->async_mask);                          /* clear config */
+                handle->async_buf[0] |= handle->async_value;                                     /* set setting */
+                handle->async_step = 1;                                                          /* next step */
+                if (a_ds1307_async_transfer(handle, 0, handle->async_reg,
+                                            handle->async_buf, 1) != 0)                          /* write register */
+                {
+                    a_ds1307_async_finish(handle, 1);                                            /* finish with error */
+                }
+            }
+            else
+            {
+                if (handle->async_reg == DS1307_REG_SECOND)                                      /* check second */
+                {
+                    handle->time_cache_valid = 0;                                                /* drop time cache */
+                    handle->sqw_anchor_valid = 0;                                                /* drop sqw anchor */
+                }
+                a_ds1307_bus_written(handle, handle->async_reg, handle->async_buf, 1);           /* update state */
+                a_ds1307_async_finish(handle, 0);                                                /* finish */
+            }
+            
+            break;
+        }
+        case DS1307_ASYNC_WRITE :
+        {
+            a_ds1307_bus_written(handle, handle->async_reg, handle->async_buf,
+                                 handle->async_len);                                             /* update state */
+            a_ds1307_async_finish(handle, 0);                                                    /* finish */
+            
+            break;
+        }
+        default :
+        {
+            a_ds1307_async_finish(handle, 0);                                                    /* finish */
+            
+            break;
+        }
     }
     
-    return 0;                                                                     /* success return 0 */
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief      get the chip oscillator status
+ * @brief      get the async busy status
  * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *busy pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get oscillator failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       one async operation runs at a time per handle, do not mix it with blocking calls
  */
-uint8_t ds1307_get_oscillator(ds1307_handle_t *handle, ds1307_bool_t *enable)
+uint8_t ds1307_get_async_busy(ds1307_handle_t *handle, ds1307_bool_t *busy)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                      /* check handle */
+    DS1307_PROBE_ENTER(handle);                                                                /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                          /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                                                     /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_SECOND, (uint8_t *)&prev, 1);        /* multiple read */
-    if (res != 0)                                                                            /* check result */
-    {
-        handle->debug_print("ds1307: read second failed.\n");                                /* read second failed */
-        
-        return 1;                                                                            /* return error */
-    }
-    *enable = (ds1307_bool_t)(!((prev >> 7) & 0x01));                                        /* get enable */
+    *busy = (handle->async_op != DS1307_ASYNC_IDLE) ? DS1307_BOOL_TRUE : DS1307_BOOL_FALSE;    /* get busy */
+    DS1307_MEMORY_BARRIER();                                                                   /* read the busy flag first */
     
-    return 0;                                                                                /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief     set the output level
+ * @brief     begin a transaction
  * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] level output level
+ * @param[in] *tr pointer to a transaction structure
  * @return    status code
  *            - 0 success
- *            - 1 set output level failed
- *            - 2 handle is NULL
+ *            - 2 handle or tr is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ds1307_set_output_level(ds1307_handle_t *handle, ds1307_output_level_t level)
+uint8_t ds1307_transaction_begin(ds1307_handle_t *handle, ds1307_transaction_t *tr)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                            /* check handle */
+    DS1307_PROBE_ENTER(handle);                                                          /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                                    /* check handle */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                                               /* check handle initialization */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                        /* return error */
     }
-    
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_CONTROL, &prev, 1);        /* read control */
-    if (res != 0)                                                                  /* check result */
+    if (DS1307_CHECK(tr == NULL))                                                        /* check tr */
     {
-        handle->debug_print("ds1307: read control failed.\n");                     /* read control failed */
+        DS1307_LOG(handle, DS1307_LOG_TR_IS_NULL, 0);                                    /* tr is null */
         
-        return 1;                                                                  /* return error */
+        return 2;                                                                        /* return error */
     }
-    prev &= ~(1 << 7);                                                             /* clear config */
-    prev |= level << 7;                                                            /* set setting */
-    res = a_ds1307_iic_write(handle, DS1307_REG_CONTROL, prev);                    /* write control */
-    if (res != 0)                                                                  /* check result */
+    
+    tr->handle = handle;                                                                 /* set handle */
+    tr->msg_num = 0;                                                                     /* no message */
+    tr->data_len = 0;                                                                    /* no data */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      queue a time read
+ * @param[in]  *tr pointer to a transaction structure
+ * @param[out] *t pointer to a time structure, valid after the commit
+ * @return     status code
+ *             - 0 success
+ *             - 2 tr or time is NULL
+ *             - 3 transaction is not begun
+ *             - 4 transaction is full
+ * @note       none
+ */
+uint8_t ds1307_transaction_read_time(ds1307_transaction_t *tr, ds1307_time_t *t)
+{
+    DS1307_PROBE_ENTER(tr);                                                              /* probe entry and exit */
+    if (DS1307_CHECK(tr == NULL))                                                        /* check tr */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(tr->handle == NULL))                                                /* check transaction */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(t == NULL))                                                         /* check time */
     {
-        handle->debug_print("ds1307: write control failed.\n");                    /* write control failed */
+        DS1307_LOG(tr->handle, DS1307_LOG_TIME_IS_NULL, 0);                              /* time is null */
         
-        return 1;                                                                  /* return error */
+        return 2;                                                                        /* return error */
     }
     
-    return 0;                                                                      /* success return 0 */
+    if (a_ds1307_transaction_read(tr, DS1307_REG_SECOND, NULL, 7,
+                                  DS1307_TRANSACTION_TIME, t) != 0)                      /* queue read */
+    {
+        return 4;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the output level
- * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[out] *level pointer to an output level buffer
+ * @brief      queue an output config read
+ * @param[in]  *tr pointer to a transaction structure
+ * @param[out] *config pointer to an output config structure, valid after the commit
  * @return     status code
  *             - 0 success
- *             - 1 get output level failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
+ *             - 2 tr or config is NULL
+ *             - 3 transaction is not begun
+ *             - 4 transaction is full
  * @note       none
  */
-uint8_t ds1307_get_output_level(ds1307_handle_t *handle, ds1307_output_level_t *level)
+uint8_t ds1307_transaction_read_control(ds1307_transaction_t *tr, ds1307_output_config_t *config)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                            /* check handle */
+    DS1307_PROBE_ENTER(tr);                                                              /* probe entry and exit */
+    if (DS1307_CHECK(tr == NULL))                                                        /* check tr */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (DS1307_CHECK(tr->handle == NULL))                                                /* check transaction */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                        /* return error */
     }
-    
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_CONTROL, &prev, 1);        /* read control */
-    if (res != 0)                                                                  /* check result */
+    if (DS1307_CHECK(config == NULL))                                                    /* check config */
     {
-        handle->debug_print("ds1307: read control failed.\n");                     /* read control failed */
+        DS1307_LOG(tr->handle, DS1307_LOG_CONFIG_IS_NULL, 0);                            /* config is null */
         
-        return 1;                                                                  /* return error */
+        return 2;                                                                        /* return error */
     }
-    *level = (ds1307_output_level_t)((prev >> 7) & 0x01);                          /* set level */
     
-    return 0;                                                                      /* success return 0 */
+    if (a_ds1307_transaction_read(tr, DS1307_REG_CONTROL, NULL, 1,
+                                  DS1307_TRANSACTION_CONTROL, config) != 0)              /* queue read */
+    {
+        return 4;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the output mode
- * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] mode output mode
+ * @brief     queue an output config write
+ * @param[in] *tr pointer to a transaction structure
+ * @param[in] *config pointer to an output config structure
  * @return    status code
  *            - 0 success
- *            - 1 set output mode failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 2 tr or config is NULL
+ *            - 3 transaction is not begun
+ *            - 4 transaction is full
+ * @note      the whole control register is written, the value is copied when queued
  */
-uint8_t ds1307_set_output_mode(ds1307_handle_t *handle, ds1307_output_mode_t mode)
+uint8_t ds1307_transaction_write_control(ds1307_transaction_t *tr, ds1307_output_config_t *config)
 {
-    uint8_t res;
-    uint8_t prev;
+    uint8_t control;
     
-    if (handle == NULL)                                                            /* check handle */
+    DS1307_PROBE_ENTER(tr);                                                              /* probe entry and exit */
+    if (DS1307_CHECK(tr == NULL))                                                        /* check tr */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (DS1307_CHECK(tr->handle == NULL))                                                /* check transaction */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                        /* return error */
     }
-    
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_CONTROL, &prev, 1);        /* read control */
-    if (res != 0)                                                                  /* check result */
+    if (DS1307_CHECK(config == NULL))                                                    /* check config */
     {
-        handle->debug_print("ds1307: read control failed.\n");                     /* read control failed */
+        DS1307_LOG(tr->handle, DS1307_LOG_CONFIG_IS_NULL, 0);                            /* config is null */
         
-        return 1;                                                                  /* return error */
+        return 2;                                                                        /* return error */
     }
-    prev &= ~(1 << 4);                                                             /* clear config */
-    prev |= mode << 4;                                                             /* set setting */
-    res = a_ds1307_iic_write(handle, DS1307_REG_CONTROL, prev);                    /* write control */
-    if (res != 0)                                                                  /* check result */
+    
+    control = (uint8_t)(((config->level & 0x01) << 7) |
+                        ((config->mode & 0x01) << 4) |
+                        ((config->freq & 0x03) << 0));                                   /* set control */
+    if (a_ds1307_transaction_write(tr, DS1307_REG_CONTROL, &control, 1) != 0)            /* queue write */
     {
-        handle->debug_print("ds1307: write control failed.\n");                    /* write control failed */
-        
-        return 1;                                                                  /* return error */
+        return 4;                                                                        /* return error */
     }
     
-    return 0;                                                                      /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the output mode
- * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[out] *mode pointer to an output mode buffer
+ * @brief      queue a ram read
+ * @param[in]  *tr pointer to a transaction structure
+ * @param[in]  addr ram address
+ * @param[out] *buf pointer to a data buffer, valid after the commit
+ * @param[in]  len buffer length
  * @return     status code
  *             - 0 success
- *             - 1 get output mode failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 2 tr or buf is NULL
+ *             - 3 transaction is not begun
+ *             - 4 addr > 55
+ *             - 5 len is invalid
+ *             - 6 transaction is full
+ * @note       dirty bytes of the ram mirror win over the chip
  */
-uint8_t ds1307_get_output_mode(ds1307_handle_t *handle, ds1307_output_mode_t *mode)
+uint8_t ds1307_transaction_read_ram(ds1307_transaction_t *tr, uint8_t addr, uint8_t *buf, uint8_t len)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                            /* check handle */
+    DS1307_PROBE_ENTER(tr);                                                              /* probe entry and exit */
+    if (DS1307_CHECK(tr == NULL))                                                        /* check tr */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (DS1307_CHECK(tr->handle == NULL))                                                /* check transaction */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(buf == NULL))                                                       /* check buf */
+    {
+        DS1307_LOG(tr->handle, DS1307_LOG_BUF_IS_NULL, 0);                               /* buf is null */
+        
+        return 2;                                                                        /* return error */
     }
     
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_CONTROL, &prev, 1);        /* read control */
-    if (res != 0)                                                                  /* check result */
+    if (DS1307_CHECK(addr > 55))                                                         /* check addr */
     {
-        handle->debug_print("ds1307: read control failed.\n");                     /* read control failed */
+        DS1307_LOG(tr->handle, DS1307_LOG_ADDR_IS_INVALID, addr);                        /* addr > 55 */
         
-        return 1;                                                                  /* return error */
+        return 4;                                                                        /* return error */
+    }
+    if (DS1307_CHECK((len == 0) || (addr + len - 1 > 55)))                               /* check len */
+    {
+        DS1307_LOG(tr->handle, DS1307_LOG_LEN_IS_INVALID, len);                          /* len is invalid */
+        
+        return 5;                                                                        /* return error */
+    }
+    if (a_ds1307_transaction_read(tr, (uint8_t)(DS1307_REG_RAM + addr), buf, len,
+                                  DS1307_TRANSACTION_RAW, NULL) != 0)                    /* queue read */
+    {
+        return 6;                                                                        /* return error */
     }
-    *mode = (ds1307_output_mode_t)((prev >> 4) & 0x01);                            /* set mode */
     
-    return 0;                                                                      /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the square wave frequency
- * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] freq square wave frequency
+ * @brief     queue a ram write
+ * @param[in] *tr pointer to a transaction structure
+ * @param[in] addr ram address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
  * @return    status code
  *            - 0 success
- *            - 1 set square wave frequency failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 2 tr or buf is NULL
+ *            - 3 transaction is not begun
+ *            - 4 addr > 55
+ *            - 5 len is invalid
+ *            - 6 transaction is full
+ * @note      the data is copied when queued
  */
-uint8_t ds1307_set_square_wave_frequency(ds1307_handle_t *handle, ds1307_square_wave_frequency_t freq)
+uint8_t ds1307_transaction_write_ram(ds1307_transaction_t *tr, uint8_t addr, uint8_t *buf, uint8_t len)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                            /* check handle */
+    DS1307_PROBE_ENTER(tr);                                                              /* probe entry and exit */
+    if (DS1307_CHECK(tr == NULL))                                                        /* check tr */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (DS1307_CHECK(tr->handle == NULL))                                                /* check transaction */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(buf == NULL))                                                       /* check buf */
+    {
+        DS1307_LOG(tr->handle, DS1307_LOG_BUF_IS_NULL, 0);                               /* buf is null */
+        
+        return 2;                                                                        /* return error */
     }
     
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_CONTROL, &prev, 1);        /* read control */
-    if (res != 0)                                                                  /* check result */
+    if (DS1307_CHECK(addr > 55))                                                         /* check addr */
     {
-        handle->debug_print("ds1307: read control failed.\n");                     /* read control failed */
+        DS1307_LOG(tr->handle, DS1307_LOG_ADDR_IS_INVALID, addr);                        /* addr > 55 */
         
-        return 1;                                                                  /* return error */
+        return 4;                                                                        /* return error */
     }
-    prev &= ~(3 << 0);                                                             /* clear config */
-    prev |= freq << 0;                                                             /* set setting */
-    res = a_ds1307_iic_write(handle, DS1307_REG_CONTROL, prev);                    /* write control */
-    if (res != 0)                                                                  /* check result */
+    if (DS1307_CHECK((len == 0) || (addr + len - 1 > 55)))                               /* check len */
     {
-        handle->debug_print("ds1307: write control failed.\n");                    /* write control failed */
+        DS1307_LOG(tr->handle, DS1307_LOG_LEN_IS_INVALID, len);                          /* len is invalid */
         
-        return 1;                                                                  /* return error */
+        return 5;                                                                        /* return error */
+    }
+    if (a_ds1307_transaction_write(tr, (uint8_t)(DS1307_REG_RAM + addr), buf, len) != 0)  /* queue write */
+    {
+        return 6;                                                                        /* return error */
     }
     
-    return 0;                                                                      /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the square wave frequency
- * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[out] *freq pointer to a square wave frequency buffer
- * @return     status code
- *             - 0 success
- *             - 1 get square wave frequency failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     commit a transaction
+ * @param[in] *tr pointer to a transaction structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 commit failed
+ *            - 2 tr is NULL
+ *            - 3 transaction is not begun
+ * @note      with iic_transfer linked every queued message goes out in one call,
+ *            otherwise the operations run one by one, the queue is kept so the
+ *            same transaction can be committed again
  */
-uint8_t ds1307_get_square_wave_frequency(ds1307_handle_t *handle, ds1307_square_wave_frequency_t *freq)
+uint8_t ds1307_transaction_commit(ds1307_transaction_t *tr)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t i;
+    uint32_t start;
+    uint64_t tick;
+    uint64_t lock_ns;
+    uint64_t start_ns;
+#if (DS1307_CONFIG_STATS != 0) || (DS1307_CONFIG_TRACE != 0)
+    uint32_t in;
+    uint32_t out;
+#endif
+    ds1307_handle_t *handle;
     
-    if (handle == NULL)                                                            /* check handle */
+    DS1307_PROBE_ENTER(tr);                                                                          /* probe entry and exit */
+    if (DS1307_CHECK(tr == NULL))                                                                    /* check tr */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (DS1307_CHECK((tr->handle == NULL) || (tr->handle->inited != 1)))                             /* check transaction */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                                    /* return error */
     }
     
-    res = a_ds1307_iic_multiple_read(handle, DS1307_REG_CONTROL, &prev, 1);        /* read control */
-    if (res != 0)                                                                  /* check result */
+    handle = tr->handle;                                                                             /* get handle */
+    DS1307_API_ENTER(DS1307_STATS_OP_TRANSACTION);                                                   /* api entry */
+    tick = ((handle->time_cache != 0) && (handle->get_tick_ns != NULL)) ? handle->get_tick_ns() : 0; /* get tick */
+    res = 0;                                                                                         /* init 0 */
+    if (handle->iic_transfer != NULL)                                                                /* check transfer */
+    {
+        lock_ns = DS1307_TRACE_TICK(handle);                                                         /* trace lock request */
+        a_ds1307_lock(handle);                                                                       /* lock */
+        start = DS1307_STATS_START(handle);                                                          /* stats start */
+        start_ns = DS1307_TRACE_TICK(handle);                                                        /* trace transport start */
+        res = handle->iic_transfer(handle->user, tr->msg, tr->msg_num);                              /* one transfer */
+#if (DS1307_CONFIG_STATS != 0) || (DS1307_CONFIG_TRACE != 0)
+        in = 0;                                                                                      /* init 0 */
+        out = 0;                                                                                     /* init 0 */
+        for (i = 0; i < tr->msg_num; i++)                                                            /* all messages */
+        {
+            if (tr->msg[i].flags == DS1307_IIC_MSG_READ)                                             /* if read */
+            {
+                in += tr->msg[i].len;                                                                /* count input */
+            }
+            else
+            {
+                out += tr->msg[i].len;                                                               /* count output */
+            }
+        }
+#endif
+        DS1307_STATS_COUNT(handle, DS1307_STATS_OP_TRANSACTION, in, out);                            /* count transfer */
+        DS1307_STATS_LATENCY(handle, DS1307_STATS_OP_TRANSACTION, res, start);                       /* count latency */
+        a_ds1307_unlock(handle);                                                                     /* unlock */
+        DS1307_TRACE(handle, &api, (in != 0) ? 1 : 0, (tr->msg_num != 0) ? tr->msg[0].buf[0] : 0,
+                     (uint16_t)(in + out), lock_ns, start_ns, res);                                  /* trace transfer */
+    }
+    else
+    {
+        for (i = 0; (i < tr->msg_num) && (res == 0); i++)                                            /* all messages */
+        {
+            if (a_ds1307_transaction_is_address(tr, i) != 0)                                         /* if read */
+            {
+                res = a_ds1307_bus_read(handle, &api, tr->msg[i].buf[0], tr->msg[i + 1].buf,
+                                        tr->msg[i + 1].len);                                         /* read */
+                i++;                                                                                 /* skip the read */
+            }
+            else
+            {
+                res = a_ds1307_bus_write(handle, &api, tr->msg[i].buf[0], &tr->msg[i].buf[1],
+                                         (uint16_t)(tr->msg[i].len - 1));                            /* write */
+            }
+        }
+    }
+    if (res != 0)                                                                                    /* check result */
     {
-        handle->debug_print("ds1307: read control failed.\n");                     /* read control failed */
+        for (i = 0; i < tr->msg_num; i++)                                                            /* all messages */
+        {
+            if ((tr->msg[i].flags == DS1307_IIC_MSG_WRITE) &&
+                (a_ds1307_transaction_is_address(tr, i) == 0))                                       /* if write */
+            {
+                a_ds1307_reg_cache_drop(handle, tr->msg[i].buf[0], (uint16_t)(tr->msg[i].len - 1));  /* drop cache */
+            }
+        }
+        DS1307_LOG(handle, DS1307_LOG_TRANSACTION_COMMIT_FAILED, 0);                                 /* transaction commit failed */
         
-        return 1;                                                                  /* return error */
+        return 1;                                                                                    /* return error */
     }
-    *freq = (ds1307_square_wave_frequency_t)(prev & 0x3);                          /* set freq */
+    a_ds1307_transaction_done(handle, tr, tick);                                                     /* update state */
     
-    return 0;                                                                      /* success return 0 */
+    return 0;                                                                                        /* success return 0 */
 }
 
 /**
@@ -767,38 +4736,46 @@ uint8_t ds1307_get_square_wave_frequency(ds1307_handle_t *handle, ds1307_square_
  *             - 3 handle is not initialized
  *             - 4 addr > 55
  *             - 5 len is invalid
- * @note       none
+ * @note       served from the ram mirror when the ram cache is enabled
  */
 uint8_t ds1307_read_ram(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                            /* check handle */
+    DS1307_PROBE_ENTER(handle);                                                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                              /* check handle */
     {
         return 2;                                                                  /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                                         /* check handle initialization */
     {
         return 3;                                                                  /* return error */
     }
-    if (addr > 55)                                                                 /* check addr */
+    DS1307_API_ENTER(DS1307_STATS_OP_READ_RAM);                                    /* api entry */
+    if (DS1307_CHECK(addr > 55))                                                   /* check addr */
     {
-        handle->debug_print("ds1307: addr > 55.\n");                               /* addr > 55 */
+        DS1307_LOG(handle, DS1307_LOG_ADDR_IS_INVALID, addr);                      /* addr > 55 */
         
         return 4;                                                                  /* return error */
     }
-    if (addr + len - 1 > 55)                                                       /* check len */
+    if (DS1307_CHECK(addr + len - 1 > 55))                                         /* check len */
     {
-        handle->debug_print("ds1307: len is invalid.\n");                          /* len is invalid */
+        DS1307_LOG(handle, DS1307_LOG_LEN_IS_INVALID, len);                        /* len is invalid */
         
         return 5;                                                                  /* return error */
     }
     
-    res = a_ds1307_iic_multiple_read(handle, (uint8_t)(DS1307_REG_RAM + addr),
+    if (handle->ram_cache != DS1307_RAM_CACHE_DISABLE)                             /* check ram cache */
+    {
+        memcpy(buf, &handle->ram[addr], len);                                      /* read the mirror */
+        
+        return 0;                                                                  /* success return 0 */
+    }
+    res = a_ds1307_iic_multiple_read(handle, &api, (uint8_t)(DS1307_REG_RAM + addr),
                                      buf, len);                                    /* read ram */
     if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("ds1307: read ram failed.\n");                         /* read ram failed */
+        DS1307_LOG(handle, DS1307_LOG_READ_RAM_FAILED, 0);                         /* read ram failed */
         
         return 1;                                                                  /* return error */
     }
@@ -819,41 +4796,55 @@ uint8_t ds1307_read_ram(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uin
  *            - 3 handle is not initialized
  *            - 4 addr > 55
  *            - 5 len is invalid
- * @note      none
+ * @note      in write back mode the data only reaches the chip on ds1307_flush_ram_cache
+ *            or ds1307_deinit
  */
 uint8_t ds1307_write_ram(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                            /* check handle */
+    DS1307_PROBE_ENTER(handle);                                                    /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                              /* check handle */
     {
         return 2;                                                                  /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                                         /* check handle initialization */
     {
         return 3;                                                                  /* return error */
     }
-    if (addr > 55)                                                                 /* check addr */
+    DS1307_API_ENTER(DS1307_STATS_OP_WRITE_RAM);                                   /* api entry */
+    if (DS1307_CHECK(addr > 55))                                                   /* check addr */
     {
-        handle->debug_print("ds1307: addr > 55.\n");                               /* addr > 55 */
+        DS1307_LOG(handle, DS1307_LOG_ADDR_IS_INVALID, addr);                      /* addr > 55 */
         
         return 4;                                                                  /* return error */
     }
-    if (addr + len - 1 > 55)                                                       /* check len */
+    if (DS1307_CHECK(addr + len - 1 > 55))                                         /* check len */
     {
-        handle->debug_print("ds1307: len is invalid.\n");                          /* len is invalid */
+        DS1307_LOG(handle, DS1307_LOG_LEN_IS_INVALID, len);                        /* len is invalid */
         
         return 5;                                                                  /* return error */
     }
     
-    res = a_ds1307_iic_multiple_write(handle, (uint8_t)(DS1307_REG_RAM + addr),
+    if (handle->ram_cache == DS1307_RAM_CACHE_WRITE_BACK)                          /* check write back */
+    {
+        memcpy(&handle->ram[addr], buf, len);                                      /* write the mirror */
+        handle->ram_dirty |= a_ds1307_ram_mask(addr, len);                         /* flag dirty */
+        
+        return 0;                                                                  /* success return 0 */
+    }
+    res = a_ds1307_iic_multiple_write(handle, &api, (uint8_t)(DS1307_REG_RAM + addr),
                                       buf, len);                                   /* write ram */
     if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("ds1307: write ram failed.\n");                        /* write ram failed */
+        DS1307_LOG(handle, DS1307_LOG_WRITE_RAM_FAILED, 0);                        /* write ram failed */
         
         return 1;                                                                  /* return error */
     }
+    if (handle->ram_cache == DS1307_RAM_CACHE_WRITE_THROUGH)                       /* check write through */
+    {
+        memcpy(&handle->ram[addr], buf, len);                                      /* update the mirror */
+    }
     
     return 0;                                                                      /* success return 0 */
 }
@@ -870,54 +4861,71 @@ uint8_t ds1307_write_ram(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, ui
  */
 uint8_t ds1307_init(ds1307_handle_t *handle)
 {
-    if (handle == NULL)                                              /* check handle */
+    DS1307_PROBE_ENTER(handle);                                               /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                         /* check handle */
     {
-        return 2;                                                    /* return error */
+        return 2;                                                             /* return error */
     }
-    if (handle->debug_print == NULL)                                 /* check debug_print */
+    if (handle->debug_print == NULL)                                          /* check debug_print */
     {
-        return 3;                                                    /* return error */
+        return 3;                                                             /* return error */
     }
-    if (handle->iic_init == NULL)                                    /* check iic_init */
+    if ((handle->iic_init == NULL) && (handle->iic_init_ctx == NULL))         /* check iic_init */
     {
-        handle->debug_print("ds1307: iic_init is null.\n");          /* iic_init is null */
+        DS1307_LOG(handle, DS1307_LOG_IIC_INIT_IS_NULL, 0);                   /* iic_init is null */
        
-        return 3;                                                    /* return error */
+        return 3;                                                             /* return error */
     }
-    if (handle->iic_deinit == NULL)                                  /* check iic_deinit */
+    if ((handle->iic_deinit == NULL) && (handle->iic_deinit_ctx == NULL))     /* check iic_deinit */
     {
-        handle->debug_print("ds1307: iic_deinit is null.\n");        /* iic_deinit is null */
+        DS1307_LOG(handle, DS1307_LOG_IIC_DEINIT_IS_NULL, 0);                 /* iic_deinit is null */
        
-        return 3;                                                    /* return error */
+        return 3;                                                             /* return error */
     }
-    if (handle->iic_write == NULL)                                   /* check iic_write */
+    if ((handle->iic_write == NULL) && (handle->iic_write_ctx == NULL))       /* check iic_write */
     {
-        handle->debug_print("ds1307: iic_write is null.\n");         /* iic_write is null */
+        DS1307_LOG(handle, DS1307_LOG_IIC_WRITE_IS_NULL, 0);                  /* iic_write is null */
        
-        return 3;                                                    /* return error */
+        return 3;                                                             /* return error */
     }
-    if (handle->iic_read == NULL)                                    /* check iic_read */
+    if ((handle->iic_read == NULL) && (handle->iic_read_ctx == NULL))         /* check iic_read */
     {
-        handle->debug_print("ds1307: iic_read is null.\n");          /* iic_read is null */
+        DS1307_LOG(handle, DS1307_LOG_IIC_READ_IS_NULL, 0);                   /* iic_read is null */
        
-        return 3;                                                    /* return error */
+        return 3;                                                             /* return error */
     }
-    if (handle->delay_ms == NULL)                                    /* check delay_ms */
+    if (handle->delay_ms == NULL)                                             /* check delay_ms */
     {
-        handle->debug_print("ds1307: delay_ms is null.\n");          /* delay_ms is null */
+        DS1307_LOG(handle, DS1307_LOG_DELAY_MS_IS_NULL, 0);                   /* delay_ms is null */
        
-        return 3;                                                    /* return error */
+        return 3;                                                             /* return error */
     }
     
-    if (handle->iic_init() != 0)                                     /* iic init */
+#if (DS1307_CONFIG_STATS != 0)
+    memset(&handle->stats, 0, sizeof(ds1307_stats_t));                        /* clear stats */
+#endif
+    if (a_ds1307_bus_init(handle) != 0)                                       /* iic init */
     {
-        handle->debug_print("ds1307: iic init failed.\n");           /* iic init failed */
+        DS1307_LOG(handle, DS1307_LOG_IIC_INIT_FAILED, 0);                    /* iic init failed */
        
-        return 1;                                                    /* return error */
+        return 1;                                                             /* return error */
     }
-    handle->inited = 1;                                              /* flag finish initialization */
+    handle->reg_cache_valid = 0;                                              /* clear register cache */
+    handle->time_cache_valid = 0;                                             /* clear time cache */
+    handle->sqw = 0;                                                          /* clear sqw discipline */
+    handle->sqw_anchor_valid = 0;                                             /* clear sqw anchor */
+    handle->ram_cache = DS1307_RAM_CACHE_DISABLE;                             /* clear ram cache */
+    handle->ram_dirty = 0;                                                    /* clear ram dirty bytes */
+    handle->snapshot = NULL;                                                  /* unbind snapshot */
+    handle->time_pub_seq = 0;                                                 /* clear published time */
+    handle->async_op = DS1307_ASYNC_IDLE;                                     /* no async operation */
+    if (handle->time_cache_interval_ms == 0)                                  /* check time cache interval */
+    {
+        handle->time_cache_interval_ms = DS1307_TIME_CACHE_DEFAULT_INTERVAL_MS; /* set default interval */
+    }
+    handle->inited = 1;                                                       /* flag finish initialization */
     
-    return 0;                                                        /* success return 0 */
+    return 0;                                                                 /* success return 0 */
 }
 
 /**
@@ -928,25 +4936,38 @@ uint8_t ds1307_init(ds1307_handle_t *handle)
  *            - 1 iic deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      dirty ram mirror bytes are flushed first
  */
 uint8_t ds1307_deinit(ds1307_handle_t *handle)
 {
-    if (handle == NULL)                                             /* check handle */
+    DS1307_PROBE_ENTER(handle);                                     /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                               /* check handle */
     {
         return 2;                                                   /* return error */
     }
-    if (handle->inited != 1)                                        /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                          /* check handle initialization */
     {
         return 3;                                                   /* return error */
     }
+    DS1307_API_ENTER(DS1307_STATS_OP_INIT);                         /* api entry */
     
-    if (handle->iic_deinit() != 0)                                  /* iic deinit */
+    if (a_ds1307_ram_flush(handle, &api) != 0)                      /* flush dirty ram bytes */
+    {
+        DS1307_LOG(handle, DS1307_LOG_FLUSH_RAM_CACHE_FAILED, 0);   /* flush ram cache failed */
+       
+        return 1;                                                   /* return error */
+    }
+    if (a_ds1307_bus_deinit(handle) != 0)                           /* iic deinit */
     {
-        handle->debug_print("ds1307: iic deinit failed.\n");        /* iic deinit failed */
+        DS1307_LOG(handle, DS1307_LOG_IIC_DEINIT_FAILED, 0);        /* iic deinit failed */
        
         return 1;                                                   /* return error */
     }
+    handle->reg_cache_valid = 0;                                    /* clear register cache */
+    handle->time_cache_valid = 0;                                   /* clear time cache */
+    handle->sqw = 0;                                                /* clear sqw discipline */
+    handle->ram_cache = DS1307_RAM_CACHE_DISABLE;                   /* clear ram cache */
+    handle->snapshot = NULL;                                        /* unbind snapshot */
     handle->inited = 0;                                             /* flag close */
     
     return 0;                                                       /* success return 0 */
@@ -967,23 +4988,41 @@ uint8_t ds1307_deinit(ds1307_handle_t *handle)
  */
 uint8_t ds1307_set_reg(ds1307_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle == NULL)                                               /* check handle */
+    uint16_t i;
+    uint8_t addr;
+    
+    DS1307_PROBE_ENTER(handle);                                       /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                 /* check handle */
     {
         return 2;                                                     /* return error */
     }
-    if (handle->inited != 1)                                          /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                            /* check handle initialization */
     {
         return 3;                                                     /* return error */
     }
+    DS1307_API_ENTER(DS1307_STATS_OP_REG);                            /* api entry */
     
-    if (handle->iic_write(DS1307_ADDRESS, reg, buf, len) != 0)        /* write data */
+    a_ds1307_reg_cache_drop(handle, reg, len);                        /* drop cache */
+    if (a_ds1307_bus_write(handle, &api, reg, buf, len) != 0)         /* write data */
     {
         return 1;                                                     /* return error */
     }
-    else
+    a_ds1307_snapshot_update(handle, reg, buf, len);                  /* update snapshot */
+    if (handle->ram_cache == DS1307_RAM_CACHE_DISABLE)                /* check ram cache */
     {
         return 0;                                                     /* success return 0 */
     }
+    for (i = 0; i < len; i++)                                         /* check ram bytes */
+    {
+        addr = (uint8_t)(((reg + i) & 0x3F) - DS1307_REG_RAM);        /* wrapped ram address */
+        if (addr < 56)                                                /* if ram */
+        {
+            handle->ram[addr] = buf[i];                               /* the chip now holds this byte */
+            handle->ram_dirty &= ~((uint64_t)1 << addr);              /* flag clean */
+        }
+    }
+    
+    return 0;                                                         /* success return 0 */
 }
 
 /**
@@ -1001,22 +5040,24 @@ uint8_t ds1307_set_reg(ds1307_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t ds1307_get_reg(ds1307_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle == NULL)                                              /* check handle */
+    DS1307_PROBE_ENTER(handle);                                            /* probe entry and exit */
+    if (DS1307_CHECK(handle == NULL))                                      /* check handle */
     {
-        return 2;                                                    /* return error */
+        return 2;                                                          /* return error */
     }
-    if (handle->inited != 1)                                         /* check handle initialization */
+    if (DS1307_CHECK(handle->inited != 1))                                 /* check handle initialization */
     {
-        return 3;                                                    /* return error */
+        return 3;                                                          /* return error */
     }
+    DS1307_API_ENTER(DS1307_STATS_OP_REG);                                 /* api entry */
     
-    if (handle->iic_read(DS1307_ADDRESS, reg, buf, len) != 0)        /* read data */
+    if (a_ds1307_bus_read(handle, &api, reg, buf, len) != 0)               /* read data */
     {
-        return 1;                                                    /* return error */
+        return 1;                                                          /* return error */
     }
     else
     {
-        return 0;                                                    /* success return 0 */
+        return 0;                                                          /* success return 0 */
     }
 }
 
@@ -1030,7 +5071,8 @@ uint8_t ds1307_get_reg(ds1307_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t ds1307_info(ds1307_info_t *info)
 {
-    if (info == NULL)                                               /* check handle */
+    DS1307_PROBE_ENTER(NULL);                                       /* probe entry and exit */
+    if (DS1307_CHECK(info == NULL))                                 /* check handle */
     {
         return 2;                                                   /* return error */
     }
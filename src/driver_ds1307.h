@@ -40,6 +40,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include "driver_ds1307_config.h"
 
 #ifdef __cplusplus
 extern "C"{
@@ -112,6 +113,59 @@ typedef enum
     DS1307_SQUARE_WAVE_FREQUENCY_32768_HZ = 0x03,        /**< 32.768kHz */
 } ds1307_square_wave_frequency_t;
 
+/**
+ * @brief ds1307 ram cache policy enumeration definition
+ */
+typedef enum
+{
+    DS1307_RAM_CACHE_DISABLE       = 0x00,        /**< every access goes to the bus */
+    DS1307_RAM_CACHE_WRITE_THROUGH = 0x01,        /**< reads from the mirror, writes go to the bus */
+    DS1307_RAM_CACHE_WRITE_BACK    = 0x02,        /**< reads and writes use the mirror until flushed */
+} ds1307_ram_cache_t;
+
+/**
+ * @brief ds1307 raw time field enumeration definition
+ */
+typedef enum
+{
+    DS1307_RAW_FIELD_SECOND  = 0x00,        /**< second */
+    DS1307_RAW_FIELD_MINUTE  = 0x01,        /**< minute */
+    DS1307_RAW_FIELD_HOUR    = 0x02,        /**< hour in the stored format */
+    DS1307_RAW_FIELD_WEEK    = 0x03,        /**< week */
+    DS1307_RAW_FIELD_DATE    = 0x04,        /**< date */
+    DS1307_RAW_FIELD_MONTH   = 0x05,        /**< month */
+    DS1307_RAW_FIELD_YEAR    = 0x06,        /**< year */
+    DS1307_RAW_FIELD_FORMAT  = 0x07,        /**< hour format */
+    DS1307_RAW_FIELD_AM_PM   = 0x08,        /**< am pm, am in 24h format */
+    DS1307_RAW_FIELD_HOUR_24 = 0x09,        /**< hour in 24h format */
+} ds1307_raw_field_t;
+
+/**
+ * @brief ds1307 raw time structure definition
+ */
+typedef struct ds1307_raw_time_s
+{
+    uint8_t reg[7];        /**< second, minute, hour, week, date, month and year registers */
+} ds1307_raw_time_t;
+
+/**
+ * @brief ds1307 snapshot structure definition
+ */
+typedef struct ds1307_snapshot_s
+{
+    uint8_t reg[64];        /**< time, control and ram registers 0x00 - 0x3F */
+} ds1307_snapshot_t;
+
+/**
+ * @brief ds1307 output config structure definition
+ */
+typedef struct ds1307_output_config_s
+{
+    ds1307_output_level_t level;                  /**< output level */
+    ds1307_output_mode_t mode;                    /**< output mode */
+    ds1307_square_wave_frequency_t freq;          /**< square wave frequency */
+} ds1307_output_config_t;
+
 /**
  * @brief ds1307 time structure definition
  */
@@ -128,6 +182,183 @@ typedef struct ds1307_time_s
     ds1307_am_pm_t am_pm;          /**< am pm */
 } ds1307_time_t;
 
+/**
+ * @brief ds1307 iic message flag enumeration definition
+ */
+typedef enum
+{
+    DS1307_IIC_MSG_WRITE = 0x00,        /**< write message */
+    DS1307_IIC_MSG_READ  = 0x01,        /**< read message */
+} ds1307_iic_msg_flag_t;
+
+/**
+ * @brief ds1307 iic message structure definition
+ */
+typedef struct ds1307_iic_msg_s
+{
+    uint8_t addr;        /**< iic device write address */
+    uint8_t flags;       /**< message flag */
+    uint16_t len;        /**< data length */
+    uint8_t *buf;        /**< data buffer, a write starts with the register address */
+} ds1307_iic_msg_t;
+
+/**
+ * @brief ds1307 log message enumeration definition
+ * @note  the ids are stable, new messages are only appended before DS1307_LOG_MAX
+ */
+typedef enum
+{
+    DS1307_LOG_IIC_INIT_IS_NULL              = 0x01,        /**< iic_init is null */
+    DS1307_LOG_IIC_DEINIT_IS_NULL            = 0x02,        /**< iic_deinit is null */
+    DS1307_LOG_IIC_WRITE_IS_NULL             = 0x03,        /**< iic_write is null */
+    DS1307_LOG_IIC_READ_IS_NULL              = 0x04,        /**< iic_read is null */
+    DS1307_LOG_DELAY_MS_IS_NULL              = 0x05,        /**< delay_ms is null */
+    DS1307_LOG_GET_TICK_NS_IS_NULL           = 0x06,        /**< get_tick_ns is null */
+    DS1307_LOG_IIC_INIT_FAILED               = 0x07,        /**< iic init failed */
+    DS1307_LOG_IIC_DEINIT_FAILED             = 0x08,        /**< iic deinit failed */
+    DS1307_LOG_YEAR_IS_INVALID               = 0x09,        /**< year is invalid */
+    DS1307_LOG_MONTH_IS_INVALID              = 0x0A,        /**< month is invalid */
+    DS1307_LOG_WEEK_IS_INVALID               = 0x0B,        /**< week is invalid */
+    DS1307_LOG_DATE_IS_INVALID               = 0x0C,        /**< date is invalid */
+    DS1307_LOG_HOUR_IS_INVALID               = 0x0D,        /**< hour is invalid */
+    DS1307_LOG_MINUTE_IS_INVALID             = 0x0E,        /**< minute is invalid */
+    DS1307_LOG_SECOND_IS_INVALID             = 0x0F,        /**< second is invalid */
+    DS1307_LOG_FORMAT_IS_INVALID             = 0x10,        /**< format is invalid */
+    DS1307_LOG_TIME_IS_NULL                  = 0x11,        /**< time is null */
+    DS1307_LOG_TIME_IS_INVALID               = 0x12,        /**< time is invalid */
+    DS1307_LOG_EPOCH_IS_NULL                 = 0x13,        /**< epoch is null */
+    DS1307_LOG_EPOCH_IS_INVALID              = 0x14,        /**< epoch is invalid */
+    DS1307_LOG_SECOND_IS_NULL                = 0x15,        /**< second is null */
+    DS1307_LOG_RAW_IS_NULL                   = 0x16,        /**< raw is null */
+    DS1307_LOG_CONFIG_IS_NULL                = 0x17,        /**< config is null */
+    DS1307_LOG_PROFILE_IS_NULL               = 0x18,        /**< profile is null */
+    DS1307_LOG_PROFILE_IS_INVALID            = 0x19,        /**< profile is invalid */
+    DS1307_LOG_POLICY_IS_INVALID             = 0x1A,        /**< policy is invalid */
+    DS1307_LOG_STATS_IS_NULL                 = 0x1B,        /**< stats is null */
+    DS1307_LOG_SNAPSHOT_IS_NULL              = 0x1C,        /**< snapshot is null */
+    DS1307_LOG_BUF_IS_NULL                   = 0x1D,        /**< buf is null */
+    DS1307_LOG_ADDR_IS_INVALID               = 0x1E,        /**< addr > 55 */
+    DS1307_LOG_LEN_IS_INVALID                = 0x1F,        /**< len is invalid */
+    DS1307_LOG_TR_IS_NULL                    = 0x20,        /**< tr is null */
+    DS1307_LOG_READ_SECOND_FAILED            = 0x21,        /**< read second failed */
+    DS1307_LOG_WRITE_SECOND_FAILED           = 0x22,        /**< write second failed */
+    DS1307_LOG_WRITE_TIME_FAILED             = 0x23,        /**< write time failed */
+    DS1307_LOG_MULTIPLE_READ_FAILED          = 0x24,        /**< multiple read failed */
+    DS1307_LOG_READ_CONTROL_FAILED           = 0x25,        /**< read control failed */
+    DS1307_LOG_WRITE_CONTROL_FAILED          = 0x26,        /**< write control failed */
+    DS1307_LOG_SET_OUTPUT_CONFIG_FAILED      = 0x27,        /**< set output config failed */
+    DS1307_LOG_READ_RAM_FAILED               = 0x28,        /**< read ram failed */
+    DS1307_LOG_WRITE_RAM_FAILED              = 0x29,        /**< write ram failed */
+    DS1307_LOG_FLUSH_RAM_CACHE_FAILED        = 0x2A,        /**< flush ram cache failed */
+    DS1307_LOG_SNAPSHOT_FAILED               = 0x2B,        /**< snapshot failed */
+    DS1307_LOG_TIME_CACHE_IS_DISABLED        = 0x2C,        /**< time cache is disabled */
+    DS1307_LOG_REGISTER_CACHE_IS_DISABLED    = 0x2D,        /**< register cache is disabled */
+    DS1307_LOG_SQW_DISCIPLINE_IS_DISABLED    = 0x2E,        /**< sqw discipline is disabled */
+    DS1307_LOG_NO_SQW_EDGE                   = 0x2F,        /**< no sqw edge */
+    DS1307_LOG_SQW_EDGE_IS_LOST              = 0x30,        /**< sqw edge is lost */
+    DS1307_LOG_SQW_IS_NOT_LOCKED             = 0x31,        /**< sqw is not locked */
+    DS1307_LOG_ASYNC_OPERATION_IS_BUSY       = 0x32,        /**< async operation is busy */
+    DS1307_LOG_ASYNC_TRANSPORT_IS_NOT_LINKED = 0x33,        /**< async transport is not linked */
+    DS1307_LOG_ASYNC_START_FAILED            = 0x34,        /**< async start failed */
+    DS1307_LOG_TRANSACTION_IS_FULL           = 0x35,        /**< transaction is full */
+    DS1307_LOG_TRANSACTION_COMMIT_FAILED     = 0x36,        /**< transaction commit failed */
+    DS1307_LOG_LOG_BUFFER_IS_NOT_LINKED      = 0x37,        /**< log buffer is not linked */
+    DS1307_LOG_REGION_IS_INVALID             = 0x38,        /**< region is invalid */
+    DS1307_LOG_GET_EPOCH_FAILED              = 0x39,        /**< get epoch failed */
+    DS1307_LOG_REBASE_FAILED                 = 0x3A,        /**< rebase failed */
+    DS1307_LOG_EVENTS_IS_NULL                = 0x3B,        /**< events is null */
+    DS1307_LOG_KEY_IS_INVALID                = 0x3C,        /**< key is invalid */
+    DS1307_LOG_VALUE_IS_NULL                 = 0x3D,        /**< value is null */
+    DS1307_LOG_KV_IS_FULL                    = 0x3E,        /**< kv is full */
+    DS1307_LOG_MAX                           = 0x3F,        /**< message number */
+} ds1307_log_t;
+
+#if (DS1307_CONFIG_LOG_BINARY != 0)
+/**
+ * @brief ds1307 log entry structure definition
+ * @note  12 bytes without padding, a raw dump of the ring decodes on any little endian host
+ */
+typedef struct ds1307_log_entry_s
+{
+    uint32_t seq;         /**< sequence number from 1, 0 while the entry is written */
+    uint32_t tick;        /**< get_tick_ns in us, 0 when it is not linked */
+    uint16_t id;          /**< message id */
+    uint16_t arg;         /**< numeric argument, 0 when the message has none */
+} ds1307_log_entry_t;
+#endif
+
+#if (DS1307_CONFIG_STATS != 0)
+/**
+ * @brief ds1307 stats operation enumeration definition
+ */
+typedef enum
+{
+    DS1307_STATS_OP_INIT          = 0x00,        /**< init and deinit */
+    DS1307_STATS_OP_GET_TIME      = 0x01,        /**< time, epoch, raw time and time cache reads */
+    DS1307_STATS_OP_SET_TIME      = 0x02,        /**< time and epoch writes */
+    DS1307_STATS_OP_READ_CONTROL  = 0x03,        /**< oscillator and output reads */
+    DS1307_STATS_OP_WRITE_CONTROL = 0x04,        /**< oscillator, output and sqw discipline writes */
+    DS1307_STATS_OP_READ_RAM      = 0x05,        /**< ram reads */
+    DS1307_STATS_OP_WRITE_RAM     = 0x06,        /**< ram writes and ram cache flushes */
+    DS1307_STATS_OP_REG           = 0x07,        /**< raw register access */
+    DS1307_STATS_OP_SNAPSHOT      = 0x08,        /**< snapshots */
+    DS1307_STATS_OP_ASYNC         = 0x09,        /**< async transfers */
+    DS1307_STATS_OP_TRANSACTION   = 0x0A,        /**< transaction commits */
+    DS1307_STATS_OP_MAX           = 0x0B,        /**< operation number */
+} ds1307_stats_op_t;
+
+/**
+ * @brief ds1307 stats bucket number definition
+ * @note  bucket 0 counts latencies of 0 and 1 tick, bucket n counts 2^n to 2^(n+1) - 1 ticks
+ */
+#define DS1307_STATS_BUCKET_NUM        32        /**< covers the whole 32 bit tick range */
+
+/**
+ * @brief ds1307 operation stats structure definition
+ */
+typedef struct ds1307_op_stats_s
+{
+    uint32_t transaction;                                  /**< bus transfers */
+    uint32_t byte_in;                                      /**< bytes read from the chip */
+    uint32_t byte_out;                                     /**< bytes written to the chip, register addresses included */
+    uint32_t error;                                        /**< failed transfers */
+    uint32_t retry;                                        /**< transfers repeated by the driver */
+    uint32_t histogram[DS1307_STATS_BUCKET_NUM];           /**< log2 latency histogram in stats ticks */
+} ds1307_op_stats_t;
+
+/**
+ * @brief ds1307 stats structure definition
+ */
+typedef struct ds1307_stats_s
+{
+    ds1307_op_stats_t op[DS1307_STATS_OP_MAX];        /**< stats of every operation */
+} ds1307_stats_t;
+#endif
+
+#if (DS1307_CONFIG_TRACE != 0)
+/**
+ * @brief ds1307 trace event structure definition
+ */
+typedef struct ds1307_trace_s
+{
+    const char *api;          /**< public api that issued the transfer */
+    uint8_t read;             /**< 1 for a read, 0 for a write */
+    uint8_t reg;              /**< first register, the first message of a transaction */
+    uint16_t len;             /**< data length */
+    uint8_t res;              /**< transport result */
+    uint64_t lock_ns;         /**< tick when the bus lock was requested */
+    uint64_t start_ns;        /**< tick when the transport was called */
+    uint64_t end_ns;          /**< tick when the transport returned */
+} ds1307_trace_t;
+#endif
+
+struct ds1307_handle_s;
+
+/**
+ * @brief ds1307 async callback definition
+ */
+typedef void (*ds1307_async_callback_t)(struct ds1307_handle_s *handle, uint8_t res, void *arg);
+
 /**
  * @brief ds1307 handle structure definition
  */
@@ -139,9 +370,101 @@ typedef struct ds1307_handle_s
     uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
+    uint64_t (*get_tick_ns)(void);                                                      /**< point to a get_tick_ns function address */
+    uint8_t (*iic_init_ctx)(void *user);                                                /**< point to an iic_init_ctx function address */
+    uint8_t (*iic_deinit_ctx)(void *user);                                              /**< point to an iic_deinit_ctx function address */
+    uint8_t (*iic_write_ctx)(void *user, uint8_t addr, uint8_t reg,
+                             uint8_t *buf, uint16_t len);                               /**< point to an iic_write_ctx function address */
+    uint8_t (*iic_read_ctx)(void *user, uint8_t addr, uint8_t reg,
+                            uint8_t *buf, uint16_t len);                                /**< point to an iic_read_ctx function address */
+    void *user;                                                                         /**< user context passed to the ctx functions */
+    void (*lock)(void *user);                                                           /**< point to a lock function address */
+    void (*unlock)(void *user);                                                         /**< point to an unlock function address */
+    uint8_t (*iic_read_async)(void *user, uint8_t addr, uint8_t reg,
+                              uint8_t *buf, uint16_t len, void *token);                 /**< point to an iic_read_async function address */
+    uint8_t (*iic_write_async)(void *user, uint8_t addr, uint8_t reg,
+                               uint8_t *buf, uint16_t len, void *token);                /**< point to an iic_write_async function address */
+    uint8_t (*iic_transfer)(void *user, ds1307_iic_msg_t *msg, uint8_t len);            /**< point to an iic_transfer function address */
     uint8_t inited;                                                                     /**< inited flag */
+    uint8_t reg_cache;                                                                  /**< register cache enable flag */
+    uint8_t reg_cache_valid;                                                            /**< register cache valid flags */
+    uint8_t control;                                                                    /**< control register shadow */
+    uint8_t ch;                                                                         /**< clock halt bit shadow */
+    uint8_t time_cache;                                                                 /**< time cache enable flag */
+    uint8_t time_cache_valid;                                                           /**< time cache valid flag */
+    uint8_t time_cache_format;                                                          /**< time cache hour format */
+    uint8_t time_cache_week;                                                            /**< time cache anchor week */
+    uint32_t time_cache_interval_ms;                                                    /**< time cache resync interval */
+    uint32_t time_cache_second;                                                         /**< time cache anchor in seconds since 2000 */
+    uint64_t time_cache_tick;                                                           /**< time cache anchor tick */
+    uint8_t sqw;                                                                        /**< sqw discipline enable flag */
+    uint8_t sqw_anchor_valid;                                                           /**< sqw anchor valid flag */
+    uint8_t sqw_anchor_format;                                                          /**< sqw anchor hour format */
+    uint8_t sqw_anchor_week;                                                            /**< sqw anchor week */
+    uint32_t sqw_anchor_edge;                                                           /**< sqw edge counter at the anchor */
+    uint32_t sqw_anchor_second;                                                         /**< sqw anchor in seconds since 2000 */
+    volatile uint32_t sqw_seq;                                                          /**< sqw edge sequence, twice the edge count */
+    volatile uint64_t sqw_edge_tick;                                                    /**< tick of the last sqw edge */
+    uint8_t ram_cache;                                                                  /**< ram cache policy */
+    uint8_t ram[56];                                                                    /**< ram mirror */
+    uint64_t ram_dirty;                                                                 /**< ram mirror dirty bitmap */
+    ds1307_snapshot_t *snapshot;                                                        /**< bound snapshot */
+    volatile uint32_t time_pub_seq;                                                     /**< published time sequence, odd while written */
+    ds1307_time_t time_pub;                                                             /**< published time */
+    uint64_t time_pub_tick;                                                             /**< tick of the published time */
+    volatile uint8_t async_op;                                                          /**< async operation in flight */
+    uint8_t async_step;                                                                 /**< async operation step */
+    uint8_t async_reg;                                                                  /**< async register address */
+    uint8_t async_len;                                                                  /**< async data length */
+    uint8_t async_mask;                                                                 /**< async update mask */
+    uint8_t async_value;                                                                /**< async update value */
+    uint8_t async_buf[56];                                                              /**< async transfer buffer */
+    uint8_t *async_out;                                                                 /**< async read destination */
+    ds1307_time_t async_time;                                                           /**< async time to write */
+    ds1307_time_t *async_time_out;                                                      /**< async time destination */
+    uint64_t async_tick;                                                                /**< tick at the start of an async time read */
+    ds1307_async_callback_t async_callback;                                             /**< async completion callback */
+    void *async_arg;                                                                    /**< async callback argument */
+#if (DS1307_CONFIG_TRACE != 0)
+    void (*trace)(void *user, ds1307_trace_t *event);                                   /**< point to a trace function address */
+#endif
+#if (DS1307_CONFIG_STATS != 0)
+    uint32_t (*stats_tick)(void);                                                       /**< point to a stats_tick function address */
+    uint32_t stats_async_tick;                                                          /**< start tick of the async transfer */
+    ds1307_stats_t stats;                                                               /**< bus counters and latency histograms */
+#endif
+#if (DS1307_CONFIG_LOG_BINARY != 0)
+    ds1307_log_entry_t *log_buf;                                                        /**< log ring */
+    uint32_t log_num;                                                                   /**< log ring entry number, a power of 2 */
+    volatile uint32_t log_head;                                                         /**< entries ever written */
+    uint32_t log_tail;                                                                  /**< entries ever read */
+#endif
 } ds1307_handle_t;
 
+/**
+ * @brief ds1307 transaction max message definition
+ */
+#define DS1307_TRANSACTION_MAX_MSG        42         /**< linux I2C_RDWR accepts 42 messages */
+
+/**
+ * @brief ds1307 transaction max data definition
+ */
+#define DS1307_TRANSACTION_MAX_DATA       128        /**< bytes for register addresses, times and written data */
+
+/**
+ * @brief ds1307 transaction structure definition
+ */
+typedef struct ds1307_transaction_s
+{
+    ds1307_handle_t *handle;                                 /**< ds1307 handle */
+    ds1307_iic_msg_t msg[DS1307_TRANSACTION_MAX_MSG];        /**< queued messages */
+    uint8_t op[DS1307_TRANSACTION_MAX_MSG];                  /**< decode operation of every message */
+    void *out[DS1307_TRANSACTION_MAX_MSG];                   /**< decode destination of every message */
+    uint8_t data[DS1307_TRANSACTION_MAX_DATA];               /**< message data */
+    uint8_t msg_num;                                         /**< queued message number */
+    uint8_t data_len;                                        /**< used data length */
+} ds1307_transaction_t;
+
 /**
  * @brief ds1307 information structure definition
  */
@@ -217,6 +540,138 @@ typedef struct ds1307_info_s
  */
 #define DRIVER_DS1307_LINK_DELAY_MS(HANDLE, FUC)          (HANDLE)->delay_ms = FUC
 
+/**
+ * @brief     link get_tick_ns function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to a get_tick_ns function address
+ * @note      optional, only the time cache needs it
+ */
+#define DRIVER_DS1307_LINK_GET_TICK_NS(HANDLE, FUC)       (HANDLE)->get_tick_ns = FUC
+
+/**
+ * @brief     link iic_init_ctx function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to an iic_init_ctx function address
+ * @note      a linked ctx function is used instead of the plain one
+ */
+#define DRIVER_DS1307_LINK_IIC_INIT_CTX(HANDLE, FUC)      (HANDLE)->iic_init_ctx = FUC
+
+/**
+ * @brief     link iic_deinit_ctx function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to an iic_deinit_ctx function address
+ * @note      a linked ctx function is used instead of the plain one
+ */
+#define DRIVER_DS1307_LINK_IIC_DEINIT_CTX(HANDLE, FUC)    (HANDLE)->iic_deinit_ctx = FUC
+
+/**
+ * @brief     link iic_read_ctx function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to an iic_read_ctx function address
+ * @note      a linked ctx function is used instead of the plain one
+ */
+#define DRIVER_DS1307_LINK_IIC_READ_CTX(HANDLE, FUC)      (HANDLE)->iic_read_ctx = FUC
+
+/**
+ * @brief     link iic_write_ctx function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to an iic_write_ctx function address
+ * @note      a linked ctx function is used instead of the plain one
+ */
+#define DRIVER_DS1307_LINK_IIC_WRITE_CTX(HANDLE, FUC)     (HANDLE)->iic_write_ctx = FUC
+
+/**
+ * @brief     link the user context
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] USER pointer to a user context
+ * @note      passed unchanged to every ctx function
+ */
+#define DRIVER_DS1307_LINK_USER(HANDLE, USER)             (HANDLE)->user = USER
+
+/**
+ * @brief     link lock function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to a lock function address
+ * @note      optional, held around every bus transaction, the time publication, the time cache
+ *            and the cached clock halt bit, so only ds1307_get_time and ds1307_get_last_time may
+ *            run concurrently, every other api still needs external serialization
+ */
+#define DRIVER_DS1307_LINK_LOCK(HANDLE, FUC)              (HANDLE)->lock = FUC
+
+/**
+ * @brief     link unlock function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to an unlock function address
+ * @note      optional, must be linked together with the lock function
+ */
+#define DRIVER_DS1307_LINK_UNLOCK(HANDLE, FUC)            (HANDLE)->unlock = FUC
+
+/**
+ * @brief     link iic_read_async function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to an iic_read_async function address
+ * @note      optional, only the async functions need it, the transport starts the transfer,
+ *            returns 0 and later calls ds1307_async_complete with the token
+ */
+#define DRIVER_DS1307_LINK_IIC_READ_ASYNC(HANDLE, FUC)    (HANDLE)->iic_read_async = FUC
+
+/**
+ * @brief     link iic_write_async function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to an iic_write_async function address
+ * @note      optional, only the async functions need it, the transport starts the transfer,
+ *            returns 0 and later calls ds1307_async_complete with the token
+ */
+#define DRIVER_DS1307_LINK_IIC_WRITE_ASYNC(HANDLE, FUC)   (HANDLE)->iic_write_async = FUC
+
+/**
+ * @brief     link iic_transfer function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to an iic_transfer function address
+ * @note      optional, a transaction is committed with one call when it is linked
+ */
+#define DRIVER_DS1307_LINK_IIC_TRANSFER(HANDLE, FUC)      (HANDLE)->iic_transfer = FUC
+
+/**
+ * @brief     link stats_tick function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to a stats_tick function address
+ * @note      optional, a free running 32 bit counter for the latency histograms,
+ *            expands to nothing when the stats are compiled out
+ */
+#if (DS1307_CONFIG_STATS != 0)
+#define DRIVER_DS1307_LINK_STATS_TICK(HANDLE, FUC)        (HANDLE)->stats_tick = FUC
+#else
+#define DRIVER_DS1307_LINK_STATS_TICK(HANDLE, FUC)
+#endif
+
+/**
+ * @brief     link trace function
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] FUC pointer to a trace function address
+ * @note      optional, called after every bus transfer with ticks of get_tick_ns,
+ *            expands to nothing when the trace is compiled out
+ */
+#if (DS1307_CONFIG_TRACE != 0)
+#define DRIVER_DS1307_LINK_TRACE(HANDLE, FUC)             (HANDLE)->trace = FUC
+#else
+#define DRIVER_DS1307_LINK_TRACE(HANDLE, FUC)
+#endif
+
+/**
+ * @brief     link the log ring
+ * @param[in] HANDLE pointer to a ds1307 handle structure
+ * @param[in] BUF pointer to a log entry buffer
+ * @param[in] NUM buffer entry number, a power of 2
+ * @note      optional, every message is also recorded into the ring as an id and an argument,
+ *            expands to nothing when the binary log is compiled out
+ */
+#if (DS1307_CONFIG_LOG_BINARY != 0)
+#define DRIVER_DS1307_LINK_LOG_BUFFER(HANDLE, BUF, NUM)   (HANDLE)->log_buf = BUF, (HANDLE)->log_num = NUM
+#else
+#define DRIVER_DS1307_LINK_LOG_BUFFER(HANDLE, BUF, NUM)
+#endif
+
 /**
  * @brief     link debug_print function
  * @param[in] HANDLE pointer to a ds1307 handle structure
@@ -266,7 +721,7 @@ uint8_t ds1307_init(ds1307_handle_t *handle);
  *            - 1 iic deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      dirty ram mirror bytes are flushed first
  */
 uint8_t ds1307_deinit(ds1307_handle_t *handle);
 
@@ -280,7 +735,7 @@ uint8_t ds1307_deinit(ds1307_handle_t *handle);
  *            - 2 handle or time is NULL
  *            - 3 handle is not initialized
  *            - 4 time is invalid
- * @note      none
+ * @note      all seven time registers are written in one burst
  */
 uint8_t ds1307_set_time(ds1307_handle_t *handle, ds1307_time_t *t);
 
@@ -293,147 +748,950 @@ uint8_t ds1307_set_time(ds1307_handle_t *handle, ds1307_time_t *t);
  *             - 1 get time failed
  *             - 2 handle or time is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       served from the time cache when it is enabled and fresh
  */
 uint8_t ds1307_get_time(ds1307_handle_t *handle, ds1307_time_t *t);
 
 /**
- * @brief      read ram
- * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[in]  addr ram address
- * @param[out] *buf pointer to a data buffer
- * @param[in]  len buffer length
- * @return     status code
- *             - 0 success
- *             - 1 read ram failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 addr > 55
- *             - 5 len is invalid
- * @note       none
- */
-uint8_t ds1307_read_ram(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len);
-
-/**
- * @brief     write ram
+ * @brief     set the time by a unix epoch
  * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] addr ram address
- * @param[in] *buf pointer to a data buffer
- * @param[in] len buffer length
+ * @param[in] epoch seconds since 1970-01-01 00:00:00
  * @return    status code
  *            - 0 success
- *            - 1 write ram failed
+ *            - 1 set epoch failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 addr > 55
- *            - 5 len is invalid
- * @note      none
+ *            - 4 epoch is invalid
+ * @note      2000-01-01 <= epoch < 2100-01-01, the time is written in 24H format
+ *            and the week is derived from the date
  */
-uint8_t ds1307_write_ram(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len);
+uint8_t ds1307_set_epoch(ds1307_handle_t *handle, uint32_t epoch);
 
 /**
- * @brief     enable or disable the oscillator
- * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set oscillator failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the time as a unix epoch
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *epoch pointer to a seconds since 1970-01-01 00:00:00 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get epoch failed
+ *             - 2 handle or epoch is NULL
+ *             - 3 handle is not initialized
+ * @note       the chip's week register is ignored
  */
-uint8_t ds1307_set_oscillator(ds1307_handle_t *handle, ds1307_bool_t enable);
+uint8_t ds1307_get_epoch(ds1307_handle_t *handle, uint32_t *epoch);
 
 /**
- * @brief      get the chip oscillator status
+ * @brief      get the last published time
  * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *t pointer to a time structure
+ * @param[out] *tick pointer to a tick buffer
  * @return     status code
  *             - 0 success
- *             - 1 get oscillator failed
- *             - 2 handle is NULL
+ *             - 2 handle or time is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 no time is published
+ * @note       ds1307_get_time and ds1307_set_time publish the time, this function never
+ *             touches the bus or the lock, *tick is 0 when get_tick_ns is not linked
  */
-uint8_t ds1307_get_oscillator(ds1307_handle_t *handle, ds1307_bool_t *enable);
+uint8_t ds1307_get_last_time(ds1307_handle_t *handle, ds1307_time_t *t, uint64_t *tick);
 
 /**
- * @brief     set the output level
- * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] level output level
- * @return    status code
- *            - 0 success
- *            - 1 set output level failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the seconds
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *second pointer to a second buffer
+ * @param[out] *halt pointer to a clock halt bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get second failed
+ *             - 2 handle, second or halt is NULL
+ *             - 3 handle is not initialized
+ * @note       one register is transferred
  */
-uint8_t ds1307_set_output_level(ds1307_handle_t *handle, ds1307_output_level_t level);
+uint8_t ds1307_get_second(ds1307_handle_t *handle, uint8_t *second, ds1307_bool_t *halt);
 
 /**
- * @brief      get the output level
+ * @brief      get the time of day
  * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[out] *level pointer to an output level buffer
+ * @param[out] *t pointer to a time structure
  * @return     status code
  *             - 0 success
- *             - 1 get output level failed
- *             - 2 handle is NULL
+ *             - 1 get time of day failed
+ *             - 2 handle or time is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       three registers are transferred, only hour, minute, second,
+ *             format and am_pm are written
  */
-uint8_t ds1307_get_output_level(ds1307_handle_t *handle, ds1307_output_level_t *level);
+uint8_t ds1307_get_time_of_day(ds1307_handle_t *handle, ds1307_time_t *t);
 
 /**
- * @brief     set the output mode
- * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] mode output mode
- * @return    status code
- *            - 0 success
- *            - 1 set output mode failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the date
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get date failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ * @note       four registers are transferred, only year, month, date and week are written
  */
-uint8_t ds1307_set_output_mode(ds1307_handle_t *handle, ds1307_output_mode_t mode);
+uint8_t ds1307_get_date(ds1307_handle_t *handle, ds1307_time_t *t);
 
 /**
- * @brief      get the output mode
- * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[out] *mode pointer to an output mode buffer
+ * @brief      get the seconds elapsed between two second samples
+ * @param[in]  start first second sample
+ * @param[in]  stop second second sample
+ * @param[out] *elapsed pointer to an elapsed seconds buffer
  * @return     status code
  *             - 0 success
- *             - 1 get output mode failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 2 elapsed is NULL
+ *             - 4 second is invalid
+ * @note       one minute wrap is handled, the samples must be less than a minute apart
  */
-uint8_t ds1307_get_output_mode(ds1307_handle_t *handle, ds1307_output_mode_t *mode);
+uint8_t ds1307_get_elapsed_second(uint8_t start, uint8_t stop, uint8_t *elapsed);
 
 /**
- * @brief     set the square wave frequency
- * @param[in] *handle pointer to a ds1307 handle structure
- * @param[in] freq square wave frequency
- * @return    status code
- *            - 0 success
- *            - 1 set square wave frequency failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the seconds elapsed between two time of day samples
+ * @param[in]  *start pointer to the first time structure
+ * @param[in]  *stop pointer to the second time structure
+ * @param[out] *elapsed pointer to an elapsed seconds buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 start, stop or elapsed is NULL
+ * @note       only hour, minute, second, format and am_pm are used,
+ *             one midnight wrap is handled
  */
-uint8_t ds1307_set_square_wave_frequency(ds1307_handle_t *handle, ds1307_square_wave_frequency_t freq);
+uint8_t ds1307_get_elapsed_time_of_day(ds1307_time_t *start, ds1307_time_t *stop, uint32_t *elapsed);
 
 /**
- * @brief      get the square wave frequency
+ * @brief      get the raw time registers
  * @param[in]  *handle pointer to a ds1307 handle structure
- * @param[out] *freq pointer to a square wave frequency buffer
+ * @param[out] *raw pointer to a raw time structure
  * @return     status code
  *             - 0 success
- *             - 1 get square wave frequency failed
- *             - 2 handle is NULL
+ *             - 1 get raw time failed
+ *             - 2 handle or raw is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       one burst read, nothing is decoded
  */
-uint8_t ds1307_get_square_wave_frequency(ds1307_handle_t *handle, ds1307_square_wave_frequency_t *freq);
+uint8_t ds1307_get_raw_time(ds1307_handle_t *handle, ds1307_raw_time_t *raw);
+
+/**
+ * @brief      decode one field of a raw time
+ * @param[in]  *raw pointer to a raw time structure
+ * @param[in]  field raw time field
+ * @param[out] *value pointer to a field value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 raw or value is NULL
+ *             - 4 field is invalid
+ * @note       the year is returned as 2000 - 2099
+ */
+uint8_t ds1307_raw_time_get_field(ds1307_raw_time_t *raw, ds1307_raw_field_t field, uint16_t *value);
+
+/**
+ * @brief      decode a raw time
+ * @param[in]  *raw pointer to a raw time structure
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 raw or time is NULL
+ * @note       none
+ */
+uint8_t ds1307_raw_time_decode(ds1307_raw_time_t *raw, ds1307_time_t *t);
+
+/**
+ * @brief      compare two raw times
+ * @param[in]  *a pointer to a raw time structure
+ * @param[in]  *b pointer to a raw time structure
+ * @param[out] *result pointer to a result buffer, -1 a is earlier, 0 equal, 1 a is later
+ * @return     status code
+ *             - 0 success
+ *             - 2 a, b or result is NULL
+ * @note       the clock halt bit and the week are ignored, 12h and 24h samples compare correctly
+ */
+uint8_t ds1307_raw_time_compare(ds1307_raw_time_t *a, ds1307_raw_time_t *b, int8_t *result);
+
+/**
+ * @brief      capture all 64 registers
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 snapshot failed
+ *             - 2 handle or snapshot is NULL
+ *             - 3 handle is not initialized
+ * @note       the chip is always read in one burst, even while a snapshot is bound,
+ *             and the ram mirror bytes replace the ram registers when the ram cache is enabled
+ */
+uint8_t ds1307_snapshot(ds1307_handle_t *handle, ds1307_snapshot_t *snapshot);
+
+/**
+ * @brief     bind a snapshot to the handle
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *snapshot pointer to a snapshot structure, NULL unbinds
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      while bound every driver read is served from the snapshot without bus traffic,
+ *            writes still go to the chip and update the snapshot, the time cache is bypassed,
+ *            read-modify-write setters still read the chip and never fill a cache from the snapshot
+ */
+uint8_t ds1307_bind_snapshot(ds1307_handle_t *handle, ds1307_snapshot_t *snapshot);
+
+/**
+ * @brief      start reading the current time
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure, valid when the callback reports 0
+ * @param[in]  callback completion callback
+ * @param[in]  *arg callback argument
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async operation is busy
+ *             - 5 async transport is not linked
+ * @note       always reads the chip, the time is published like ds1307_get_time
+ */
+uint8_t ds1307_get_time_async(ds1307_handle_t *handle, ds1307_time_t *t, ds1307_async_callback_t callback, void *arg);
+
+/**
+ * @brief     start writing the current time
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *t pointer to a time structure
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle or time is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ *            - 6 time is invalid
+ * @note      the second register is read first to keep the clock halt bit,
+ *            the time is copied so *t may go out of scope
+ */
+uint8_t ds1307_set_time_async(ds1307_handle_t *handle, ds1307_time_t *t, ds1307_async_callback_t callback, void *arg);
+
+/**
+ * @brief      start reading ram
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[in]  addr ram address
+ * @param[out] *buf pointer to a data buffer, valid when the callback reports 0
+ * @param[in]  len buffer length
+ * @param[in]  callback completion callback
+ * @param[in]  *arg callback argument
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ *             - 2 handle or buf is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async operation is busy
+ *             - 5 async transport is not linked
+ *             - 6 addr > 55
+ *             - 7 len is invalid
+ * @note       served from the ram mirror when the ram cache is enabled,
+ *             the callback then runs before this function returns
+ */
+uint8_t ds1307_read_ram_async(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len,
+                              ds1307_async_callback_t callback, void *arg);
+
+/**
+ * @brief     start writing ram
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] addr ram address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle or buf is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ *            - 6 addr > 55
+ *            - 7 len is invalid
+ * @note      the data is copied, in write back mode only the ram mirror is written
+ *            and the callback runs before this function returns
+ */
+uint8_t ds1307_write_ram_async(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len,
+                               ds1307_async_callback_t callback, void *arg);
+
+/**
+ * @brief     start enabling or disabling the oscillator
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ * @note      the register is read, modified and written in two transfers
+ */
+uint8_t ds1307_set_oscillator_async(ds1307_handle_t *handle, ds1307_bool_t enable, ds1307_async_callback_t callback, void *arg);
+
+/**
+ * @brief     start setting the output level
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] level output level
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ * @note      the register is read, modified and written in two transfers
+ */
+uint8_t ds1307_set_output_level_async(ds1307_handle_t *handle, ds1307_output_level_t level, ds1307_async_callback_t callback, void *arg);
+
+/**
+ * @brief     start setting the output mode
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] mode output mode
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ * @note      the register is read, modified and written in two transfers
+ */
+uint8_t ds1307_set_output_mode_async(ds1307_handle_t *handle, ds1307_output_mode_t mode, ds1307_async_callback_t callback, void *arg);
+
+/**
+ * @brief     start setting the square wave frequency
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] freq square wave frequency
+ * @param[in] callback completion callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async operation is busy
+ *            - 5 async transport is not linked
+ * @note      the register is read, modified and written in two transfers
+ */
+uint8_t ds1307_set_square_wave_frequency_async(ds1307_handle_t *handle, ds1307_square_wave_frequency_t freq, ds1307_async_callback_t callback, void *arg);
+
+/**
+ * @brief     complete the async transfer in flight
+ * @param[in] *handle pointer to a ds1307 handle structure, the token given to the transport
+ * @param[in] res transfer result, 0 means success
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 no async operation is in flight
+ * @note      called by the transport from its completion context, it may start the
+ *            next transfer or run the operation callback
+ */
+uint8_t ds1307_async_complete(ds1307_handle_t *handle, uint8_t res);
+
+/**
+ * @brief      get the async busy status
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *busy pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       one async operation runs at a time per handle, do not mix it with blocking calls
+ */
+uint8_t ds1307_get_async_busy(ds1307_handle_t *handle, ds1307_bool_t *busy);
+
+/**
+ * @brief     begin a transaction
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *tr pointer to a transaction structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or tr is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1307_transaction_begin(ds1307_handle_t *handle, ds1307_transaction_t *tr);
+
+/**
+ * @brief      queue a time read
+ * @param[in]  *tr pointer to a transaction structure
+ * @param[out] *t pointer to a time structure, valid after the commit
+ * @return     status code
+ *             - 0 success
+ *             - 2 tr or time is NULL
+ *             - 3 transaction is not begun
+ *             - 4 transaction is full
+ * @note       none
+ */
+uint8_t ds1307_transaction_read_time(ds1307_transaction_t *tr, ds1307_time_t *t);
+
+/**
+ * @brief      queue an output config read
+ * @param[in]  *tr pointer to a transaction structure
+ * @param[out] *config pointer to an output config structure, valid after the commit
+ * @return     status code
+ *             - 0 success
+ *             - 2 tr or config is NULL
+ *             - 3 transaction is not begun
+ *             - 4 transaction is full
+ * @note       none
+ */
+uint8_t ds1307_transaction_read_control(ds1307_transaction_t *tr, ds1307_output_config_t *config);
+
+/**
+ * @brief     queue an output config write
+ * @param[in] *tr pointer to a transaction structure
+ * @param[in] *config pointer to an output config structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 tr or config is NULL
+ *            - 3 transaction is not begun
+ *            - 4 transaction is full
+ * @note      the whole control register is written, the value is copied when queued
+ */
+uint8_t ds1307_transaction_write_control(ds1307_transaction_t *tr, ds1307_output_config_t *config);
+
+/**
+ * @brief      queue a ram read
+ * @param[in]  *tr pointer to a transaction structure
+ * @param[in]  addr ram address
+ * @param[out] *buf pointer to a data buffer, valid after the commit
+ * @param[in]  len buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 2 tr or buf is NULL
+ *             - 3 transaction is not begun
+ *             - 4 addr > 55
+ *             - 5 len is invalid
+ *             - 6 transaction is full
+ * @note       dirty bytes of the ram mirror win over the chip
+ */
+uint8_t ds1307_transaction_read_ram(ds1307_transaction_t *tr, uint8_t addr, uint8_t *buf, uint8_t len);
+
+/**
+ * @brief     queue a ram write
+ * @param[in] *tr pointer to a transaction structure
+ * @param[in] addr ram address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 tr or buf is NULL
+ *            - 3 transaction is not begun
+ *            - 4 addr > 55
+ *            - 5 len is invalid
+ *            - 6 transaction is full
+ * @note      the data is copied when queued
+ */
+uint8_t ds1307_transaction_write_ram(ds1307_transaction_t *tr, uint8_t addr, uint8_t *buf, uint8_t len);
+
+/**
+ * @brief     commit a transaction
+ * @param[in] *tr pointer to a transaction structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 commit failed
+ *            - 2 tr is NULL
+ *            - 3 transaction is not begun
+ * @note      with iic_transfer linked every queued message goes out in one call,
+ *            otherwise the operations run one by one, the queue is kept so the
+ *            same transaction can be committed again
+ */
+uint8_t ds1307_transaction_commit(ds1307_transaction_t *tr);
+
+/**
+ * @brief      read ram
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[in]  addr ram address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read ram failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 addr > 55
+ *             - 5 len is invalid
+ * @note       served from the ram mirror when the ram cache is enabled
+ */
+uint8_t ds1307_read_ram(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len);
+
+/**
+ * @brief     write ram
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] addr ram address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr > 55
+ *            - 5 len is invalid
+ * @note      in write back mode the data only reaches the chip on ds1307_flush_ram_cache
+ *            or ds1307_deinit
+ */
+uint8_t ds1307_write_ram(ds1307_handle_t *handle, uint8_t addr, uint8_t *buf, uint8_t len);
+
+/**
+ * @brief     enable or disable the oscillator
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set oscillator failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1307_set_oscillator(ds1307_handle_t *handle, ds1307_bool_t enable);
+
+/**
+ * @brief      get the chip oscillator status
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get oscillator failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_oscillator(ds1307_handle_t *handle, ds1307_bool_t *enable);
+
+/**
+ * @brief     set the output level
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] level output level
+ * @return    status code
+ *            - 0 success
+ *            - 1 set output level failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1307_set_output_level(ds1307_handle_t *handle, ds1307_output_level_t level);
+
+/**
+ * @brief      get the output level
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *level pointer to an output level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get output level failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_output_level(ds1307_handle_t *handle, ds1307_output_level_t *level);
+
+/**
+ * @brief     set the output mode
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] mode output mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set output mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1307_set_output_mode(ds1307_handle_t *handle, ds1307_output_mode_t mode);
+
+/**
+ * @brief      get the output mode
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *mode pointer to an output mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get output mode failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_output_mode(ds1307_handle_t *handle, ds1307_output_mode_t *mode);
+
+/**
+ * @brief     set the square wave frequency
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] freq square wave frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 set square wave frequency failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds1307_set_square_wave_frequency(ds1307_handle_t *handle, ds1307_square_wave_frequency_t freq);
+
+/**
+ * @brief      get the square wave frequency
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *freq pointer to a square wave frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get square wave frequency failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_square_wave_frequency(ds1307_handle_t *handle, ds1307_square_wave_frequency_t *freq);
+
+/**
+ * @brief     set the output level, mode and square wave frequency
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] *config pointer to an output config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set output config failed
+ *            - 2 handle or config is NULL
+ *            - 3 handle is not initialized
+ * @note      the whole control register is written at once
+ */
+uint8_t ds1307_set_output_config(ds1307_handle_t *handle, ds1307_output_config_t *config);
+
+/**
+ * @brief      get the output level, mode and square wave frequency
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *config pointer to an output config structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get output config failed
+ *             - 2 handle or config is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_output_config(ds1307_handle_t *handle, ds1307_output_config_t *config);
+
+/**
+ * @brief     restore an output profile
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] profile raw control register value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set output profile failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 profile is invalid
+ * @note      none
+ */
+uint8_t ds1307_set_output_profile(ds1307_handle_t *handle, uint8_t profile);
+
+/**
+ * @brief      save the output profile
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *profile pointer to a raw control register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get output profile failed
+ *             - 2 handle or profile is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_output_profile(ds1307_handle_t *handle, uint8_t *profile);
+
+/**
+ * @brief     enable or disable the time cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_tick_ns is NULL
+ * @note      when enabled, ds1307_get_time extrapolates the last chip sample with
+ *            the host tick and only reads the chip once the resync interval expired
+ */
+uint8_t ds1307_set_time_cache(ds1307_handle_t *handle, ds1307_bool_t enable);
+
+/**
+ * @brief      get the time cache status
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_time_cache(ds1307_handle_t *handle, ds1307_bool_t *enable);
+
+/**
+ * @brief     set the time cache resync interval
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] ms resync interval in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      this is the maximum age of the chip sample behind a cached time
+ */
+uint8_t ds1307_set_time_cache_interval(ds1307_handle_t *handle, uint32_t ms);
+
+/**
+ * @brief      get the time cache resync interval
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *ms pointer to a resync interval buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_time_cache_interval(ds1307_handle_t *handle, uint32_t *ms);
+
+/**
+ * @brief     refresh the time cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh time cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 time cache is disabled
+ * @note      none
+ */
+uint8_t ds1307_refresh_time_cache(ds1307_handle_t *handle);
+
+/**
+ * @brief     set the ram cache policy
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] policy ram cache policy
+ * @return    status code
+ *            - 0 success
+ *            - 1 set ram cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 policy is invalid
+ * @note      enabling loads the whole ram in one burst, leaving write back flushes it first
+ */
+uint8_t ds1307_set_ram_cache(ds1307_handle_t *handle, ds1307_ram_cache_t policy);
+
+/**
+ * @brief      get the ram cache policy
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *policy pointer to a ram cache policy buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_ram_cache(ds1307_handle_t *handle, ds1307_ram_cache_t *policy);
+
+/**
+ * @brief     flush the dirty ram mirror bytes
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush ram cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      dirty runs closer than a burst header are merged into one burst
+ */
+uint8_t ds1307_flush_ram_cache(ds1307_handle_t *handle);
+
+/**
+ * @brief     enable or disable the sqw discipline
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set sqw discipline failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_tick_ns is NULL
+ * @note      enabling switches the SQW/OUT pin to the 1Hz square wave,
+ *            disabling leaves the output config untouched
+ */
+uint8_t ds1307_set_sqw_discipline(ds1307_handle_t *handle, ds1307_bool_t enable);
+
+/**
+ * @brief      get the sqw discipline status
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_sqw_discipline(ds1307_handle_t *handle, ds1307_bool_t *enable);
+
+/**
+ * @brief     sqw edge irq handler
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 sqw discipline is disabled
+ * @note      call it on every falling edge of the 1Hz SQW/OUT signal,
+ *            it never touches the bus and is safe in an interrupt
+ */
+uint8_t ds1307_sqw_irq_handler(ds1307_handle_t *handle);
+
+/**
+ * @brief      get the sqw disciplined time
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *t pointer to a time structure
+ * @param[out] *ns pointer to a nanoseconds since the second started buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get sqw time failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 sqw discipline is disabled
+ *             - 5 sqw is not locked
+ * @note       the registers are only read to lock onto the edges
+ */
+uint8_t ds1307_get_sqw_time(ds1307_handle_t *handle, ds1307_time_t *t, uint32_t *ns);
+
+/**
+ * @brief     enable or disable the register cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the cache shadows the control register and the clock halt bit,
+ *            it is filled on first access and the content is dropped on every call
+ */
+uint8_t ds1307_set_register_cache(ds1307_handle_t *handle, ds1307_bool_t enable);
+
+/**
+ * @brief      get the register cache status
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds1307_get_register_cache(ds1307_handle_t *handle, ds1307_bool_t *enable);
+
+/**
+ * @brief     invalidate the register cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it when another bus master may have changed the chip,
+ *            the next access reads the registers again
+ */
+uint8_t ds1307_invalidate_register_cache(ds1307_handle_t *handle);
+
+/**
+ * @brief     refresh the register cache
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh register cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 register cache is disabled
+ * @note      none
+ */
+uint8_t ds1307_refresh_register_cache(ds1307_handle_t *handle);
+
+#if (DS1307_CONFIG_STATS != 0)
+/**
+ * @brief      get the bus stats
+ * @param[in]  *handle pointer to a ds1307 handle structure
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or stats is NULL
+ *             - 3 handle is not initialized
+ * @note       the copy is taken under the bus lock, latencies are in ticks of the linked stats_tick
+ *             and the histograms stay empty when it is not linked
+ */
+uint8_t ds1307_get_stats(ds1307_handle_t *handle, ds1307_stats_t *stats);
+
+/**
+ * @brief     reset the bus stats
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      ds1307_init resets them too
+ */
+uint8_t ds1307_reset_stats(ds1307_handle_t *handle);
+#endif
+
+/**
+ * @brief     log a message
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] id message id
+ * @param[in] arg numeric argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 id is invalid
+ * @note      the text goes to debug_print and the id and the argument go to the linked log ring,
+ *            recording is lock free and safe from interrupts, the handle needs no init
+ */
+uint8_t ds1307_log(ds1307_handle_t *handle, ds1307_log_t id, uint16_t arg);
+
+/**
+ * @brief log definition
+ * @note  used by the driver modules, expands to nothing when the text and the binary log are both compiled out
+ */
+#if (DS1307_CONFIG_LOG_TEXT != 0) || (DS1307_CONFIG_LOG_BINARY != 0)
+#define DS1307_LOG(HANDLE, ID, ARG)        (void)ds1307_log(HANDLE, ID, (uint16_t)(ARG))
+#else
+#define DS1307_LOG(HANDLE, ID, ARG)        (void)(HANDLE)
+#endif
+
+#if (DS1307_CONFIG_LOG_BINARY != 0)
+/**
+ * @brief         read the log ring
+ * @param[in]     *handle pointer to a ds1307 handle structure
+ * @param[out]    *entry pointer to a log entry buffer
+ * @param[in,out] *len pointer to a length buffer
+ * @param[out]    *lost pointer to a lost entry number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle, entry, len or lost is NULL
+ *                - 4 log ring is not linked
+ * @note          returns the oldest unread entries, *lost counts the entries overwritten before they were read,
+ *                one reader at a time, the handle needs no init
+ */
+uint8_t ds1307_log_read(ds1307_handle_t *handle, ds1307_log_entry_t *entry, uint32_t *len, uint32_t *lost);
+#endif
+
+#if (DS1307_CONFIG_LOG_TEXT != 0)
+/**
+ * @brief      get the text of a message
+ * @param[in]  id message id
+ * @param[out] **text pointer to a text pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 text is NULL
+ *             - 4 id is invalid
+ * @note       decodes the ids of a log ring dump
+ */
+uint8_t ds1307_log_get_text(uint16_t id, const char **text);
+#endif
 
 /**
  * @}
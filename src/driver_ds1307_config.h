@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_config.h
+ * @brief     driver ds1307 config header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1307_CONFIG_H
+#define DRIVER_DS1307_CONFIG_H
+
+/**
+ * @brief ds1307 check config definition
+ * @note  build with -DDS1307_CONFIG_CHECK=0 to drop the NULL, init and range checks of the api,
+ *        only for trusted callers that already pass valid arguments to an inited handle
+ */
+#ifndef DS1307_CONFIG_CHECK
+#define DS1307_CONFIG_CHECK        1        /**< argument and state checks on every api call */
+#endif
+
+/**
+ * @brief ds1307 stats config definition
+ * @note  build with -DDS1307_CONFIG_STATS=1 to compile the counters, the histograms and the stats api in,
+ *        they add about 1.6KB to every handle
+ */
+#ifndef DS1307_CONFIG_STATS
+#define DS1307_CONFIG_STATS        0        /**< per handle bus counters and latency histograms */
+#endif
+
+/**
+ * @brief ds1307 trace config definition
+ * @note  build with -DDS1307_CONFIG_TRACE=1 to compile the trace hook in
+ */
+#ifndef DS1307_CONFIG_TRACE
+#define DS1307_CONFIG_TRACE        0        /**< trace callback around every bus transfer */
+#endif
+
+/**
+ * @brief ds1307 usdt config definition
+ * @note  build with -DDS1307_CONFIG_USDT=1 on linux to place sys/sdt.h probes at the entry and exit of every api
+ */
+#ifndef DS1307_CONFIG_USDT
+#define DS1307_CONFIG_USDT         0        /**< static probes for bpftrace and perf */
+#endif
+
+/**
+ * @brief ds1307 log text config definition
+ * @note  build with -DDS1307_CONFIG_LOG_TEXT=0 to strip every message string out of the driver
+ */
+#ifndef DS1307_CONFIG_LOG_TEXT
+#define DS1307_CONFIG_LOG_TEXT     1        /**< messages printed by debug_print */
+#endif
+
+/**
+ * @brief ds1307 log binary config definition
+ * @note  build with -DDS1307_CONFIG_LOG_BINARY=1 to compile the log ring and its api in
+ */
+#ifndef DS1307_CONFIG_LOG_BINARY
+#define DS1307_CONFIG_LOG_BINARY   0        /**< message ids recorded into a linked log ring */
+#endif
+
+/**
+ * @brief check definition
+ * @note  wraps every argument check of the driver modules, folds to a constant false when the checks are compiled out
+ */
+#if (DS1307_CONFIG_CHECK != 0)
+#define DS1307_CHECK(COND)        (COND)
+#else
+#define DS1307_CHECK(COND)        (0 && (COND))
+#endif
+
+#endif
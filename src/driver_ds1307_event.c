@@ -0,0 +1,391 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_event.c
+ * @brief     driver ds1307 event source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1307_event.h"
+
+/**
+ * @brief ds1307 event max entries definition
+ */
+#define DS1307_EVENT_MAX_ENTRY        ((56 - DS1307_EVENT_HEADER_SIZE) / DS1307_EVENT_ENTRY_SIZE)        /**< max entries */
+
+/**
+ * @brief      decode the ring in chronological order
+ * @param[in]  *event pointer to a ds1307 event handle structure
+ * @param[in]  *buf pointer to the region data
+ * @param[out] *events pointer to an event buffer
+ * @return     number of events
+ * @note       none
+ */
+static uint8_t a_ds1307_event_decode(ds1307_event_handle_t *event, uint8_t *buf, ds1307_event_t *events)
+{
+    uint8_t count;
+    uint8_t first;
+    uint8_t i;
+    uint8_t *entry;
+    
+    count = (event->wrapped != 0) ? event->capacity : event->head;                      /* number of entries */
+    first = (event->wrapped != 0) ? event->head : 0;                                    /* oldest entry */
+    for (i = 0; i < count; i++)                                                         /* all entries */
+    {
+        entry = &buf[DS1307_EVENT_HEADER_SIZE +
+                     ((first + i) % event->capacity) * DS1307_EVENT_ENTRY_SIZE];        /* entry */
+        events[i].code = entry[0];                                                      /* set code */
+        events[i].epoch = event->base + ((uint32_t)entry[1] |
+                          ((uint32_t)entry[2] << 8) | ((uint32_t)entry[3] << 16));      /* set epoch */
+    }
+    
+    return count;                                                                       /* return count */
+}
+
+/**
+ * @brief     move the base epoch so that now fits the delta range
+ * @param[in] *event pointer to a ds1307 event handle structure
+ * @param[in] now current unix timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 1 rebase failed
+ * @note      events outside the new range are dropped, the region is read and written in one burst each
+ */
+static uint8_t a_ds1307_event_rebase(ds1307_event_handle_t *event, uint32_t now)
+{
+    uint8_t buf[56];
+    ds1307_event_t events[DS1307_EVENT_MAX_ENTRY];
+    uint8_t count;
+    uint8_t keep;
+    uint8_t i;
+    uint32_t base;
+    uint32_t delta;
+    uint8_t *entry;
+    
+    if (ds1307_read_ram(event->handle, event->addr, buf, event->len) != 0)              /* read the region */
+    {
+        return 1;                                                                       /* return error */
+    }
+    count = a_ds1307_event_decode(event, buf, events);                                  /* decode */
+    keep = 0;                                                                           /* init 0 */
+    base = now;                                                                         /* init now */
+    for (i = 0; i < count; i++)                                                         /* keep events in range */
+    {
+        if ((events[i].epoch <= now) && (now - events[i].epoch <= DS1307_EVENT_MAX_DELTA))
+        {
+            events[keep] = events[i];                                                   /* keep event */
+            if (events[keep].epoch < base)                                              /* check oldest */
+            {
+                base = events[keep].epoch;                                              /* set base */
+            }
+            keep++;                                                                     /* next */
+        }
+    }
+    buf[0] = DS1307_EVENT_MAGIC;                                                        /* set magic */
+    buf[1] = (uint8_t)(base >> 0);                                                      /* set base */
+    buf[2] = (uint8_t)(base >> 8);                                                      /* set base */
+    buf[3] = (uint8_t)(base >> 16);                                                     /* set base */
+    buf[4] = (uint8_t)(base >> 24);                                                     /* set base */
+    buf[5] = (keep == event->capacity) ? 0x80 : keep;                                   /* set head */
+    for (i = 0; i < keep; i++)                                                          /* re-encode */
+    {
+        entry = &buf[DS1307_EVENT_HEADER_SIZE + i * DS1307_EVENT_ENTRY_SIZE];           /* entry */
+        delta = events[i].epoch - base;                                                 /* delta */
+        entry[0] = events[i].code;                                                      /* set code */
+        entry[1] = (uint8_t)(delta >> 0);                                               /* set delta */
+        entry[2] = (uint8_t)(delta >> 8);                                               /* set delta */
+        entry[3] = (uint8_t)(delta >> 16);                                              /* set delta */
+    }
+    if (ds1307_write_ram(event->handle, event->addr, buf, event->len) != 0)             /* write the region */
+    {
+        return 1;                                                                       /* return error */
+    }
+    event->base = base;                                                                 /* set base */
+    event->head = (uint8_t)(buf[5] & 0x7F);                                             /* set head */
+    event->wrapped = (uint8_t)(buf[5] >> 7);                                            /* set wrapped */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     init the event ring
+ * @param[in] *event pointer to a ds1307 event handle structure
+ * @param[in] *handle pointer to an initialized ds1307 handle structure
+ * @param[in] addr ram region address
+ * @param[in] len ram region length
+ * @return    status code
+ *            - 0 success
+ *            - 1 read or write ram failed
+ *            - 2 event or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is invalid
+ * @note      only the header is read, a header with a wrong magic or head is rewritten as an empty ring
+ */
+uint8_t ds1307_event_init(ds1307_event_handle_t *event, ds1307_handle_t *handle, uint8_t addr, uint8_t len)
+{
+    uint8_t buf[DS1307_EVENT_HEADER_SIZE];
+    
+    if (DS1307_CHECK((event == NULL) || (handle == NULL)))                                         /* check event and handle */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                                         /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    if ((len < DS1307_EVENT_HEADER_SIZE + DS1307_EVENT_ENTRY_SIZE) || ((uint16_t)addr + len > 56)) /* check region */
+    {
+        DS1307_LOG(handle, DS1307_LOG_REGION_IS_INVALID, 0);                                       /* region is invalid */
+        
+        return 4;                                                                                  /* return error */
+    }
+    
+    if (ds1307_read_ram(handle, addr, buf, DS1307_EVENT_HEADER_SIZE) != 0)                         /* read the header */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_RAM_FAILED, 0);                                         /* read ram failed */
+        
+        return 1;                                                                                  /* return error */
+    }
+    event->handle = handle;                                                                        /* set handle */
+    event->addr = addr;                                                                            /* set address */
+    event->len = len;                                                                              /* set length */
+    event->capacity = (uint8_t)((len - DS1307_EVENT_HEADER_SIZE) / DS1307_EVENT_ENTRY_SIZE);       /* set capacity */
+    event->base = (uint32_t)buf[1] | ((uint32_t)buf[2] << 8) |
+                  ((uint32_t)buf[3] << 16) | ((uint32_t)buf[4] << 24);                             /* set base */
+    event->head = (uint8_t)(buf[5] & 0x7F);                                                        /* set head */
+    event->wrapped = (uint8_t)(buf[5] >> 7);                                                       /* set wrapped */
+    if ((buf[0] != DS1307_EVENT_MAGIC) || (event->head >= event->capacity))                        /* check header */
+    {
+        memset(buf, 0, DS1307_EVENT_HEADER_SIZE);                                                  /* empty ring */
+        buf[0] = DS1307_EVENT_MAGIC;                                                               /* set magic */
+        if (ds1307_write_ram(handle, addr, buf, DS1307_EVENT_HEADER_SIZE) != 0)                    /* write the header */
+        {
+            DS1307_LOG(handle, DS1307_LOG_WRITE_RAM_FAILED, 0);                                    /* write ram failed */
+            
+            return 1;                                                                              /* return error */
+        }
+        event->base = 0;                                                                           /* rebased by the first append */
+        event->head = 0;                                                                           /* empty ring */
+        event->wrapped = 0;                                                                        /* empty ring */
+    }
+    event->inited = 1;                                                                             /* flag finish initialization */
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     close the event ring
+ * @param[in] *event pointer to a ds1307 event handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 event is NULL
+ *            - 3 event is not initialized
+ * @note      none
+ */
+uint8_t ds1307_event_deinit(ds1307_event_handle_t *event)
+{
+    if (DS1307_CHECK(event == NULL))                  /* check event */
+    {
+        return 2;                                     /* return error */
+    }
+    if (DS1307_CHECK(event->inited != 1))             /* check event initialization */
+    {
+        return 3;                                     /* return error */
+    }
+    
+    event->inited = 0;                                /* flag close */
+    
+    return 0;                                         /* success return 0 */
+}
+
+/**
+ * @brief     append an event stamped with the current time
+ * @param[in] *event pointer to a ds1307 event handle structure
+ * @param[in] code event code
+ * @return    status code
+ *            - 0 success
+ *            - 1 append failed
+ *            - 2 event is NULL
+ *            - 3 event is not initialized
+ * @note      an append writes the entry and then the head byte, the ring is only
+ *            rebased in one burst when the delta no longer fits 24 bits
+ */
+uint8_t ds1307_event_append(ds1307_event_handle_t *event, uint8_t code)
+{
+    uint8_t entry[DS1307_EVENT_ENTRY_SIZE];
+    uint8_t head;
+    uint8_t wrapped;
+    uint32_t now;
+    uint32_t delta;
+    
+    if (DS1307_CHECK(event == NULL))                                                            /* check event */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (DS1307_CHECK(event->inited != 1))                                                       /* check event initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    if (ds1307_get_epoch(event->handle, &now) != 0)                                             /* get the time */
+    {
+        DS1307_LOG(event->handle, DS1307_LOG_GET_EPOCH_FAILED, 0);                              /* get epoch failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    if ((now < event->base) || (now - event->base > DS1307_EVENT_MAX_DELTA))                    /* check delta */
+    {
+        if (a_ds1307_event_rebase(event, now) != 0)                                             /* rebase */
+        {
+            DS1307_LOG(event->handle, DS1307_LOG_REBASE_FAILED, 0);                             /* rebase failed */
+            
+            return 1;                                                                           /* return error */
+        }
+    }
+    delta = now - event->base;                                                                  /* delta */
+    entry[0] = code;                                                                            /* set code */
+    entry[1] = (uint8_t)(delta >> 0);                                                           /* set delta */
+    entry[2] = (uint8_t)(delta >> 8);                                                           /* set delta */
+    entry[3] = (uint8_t)(delta >> 16);                                                          /* set delta */
+    if (ds1307_write_ram(event->handle, (uint8_t)(event->addr + DS1307_EVENT_HEADER_SIZE +
+                         event->head * DS1307_EVENT_ENTRY_SIZE),
+                         entry, DS1307_EVENT_ENTRY_SIZE) != 0)                                  /* write the entry */
+    {
+        DS1307_LOG(event->handle, DS1307_LOG_WRITE_RAM_FAILED, 0);                              /* write ram failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    head = (uint8_t)(event->head + 1);                                                          /* next entry */
+    wrapped = event->wrapped;                                                                   /* keep wrapped */
+    if (head == event->capacity)                                                                /* check end */
+    {
+        head = 0;                                                                               /* wrap around */
+        wrapped = 1;                                                                            /* flag wrapped */
+    }
+    entry[0] = (uint8_t)((wrapped << 7) | head);                                                /* set head */
+    if (ds1307_write_ram(event->handle, (uint8_t)(event->addr + DS1307_EVENT_HEADER_SIZE - 1),
+                         entry, 1) != 0)                                                        /* write the head */
+    {
+        DS1307_LOG(event->handle, DS1307_LOG_WRITE_RAM_FAILED, 0);                              /* write ram failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    event->head = head;                                                                         /* set head */
+    event->wrapped = wrapped;                                                                   /* set wrapped */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief         read the events
+ * @param[in]     *event pointer to a ds1307 event handle structure
+ * @param[out]    *events pointer to an event buffer
+ * @param[in,out] *len pointer to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read ram failed
+ *                - 2 event is NULL
+ *                - 3 event is not initialized
+ * @note          the ring is read in one burst, the newest *len events are returned oldest first
+ */
+uint8_t ds1307_event_read(ds1307_event_handle_t *event, ds1307_event_t *events, uint8_t *len)
+{
+    uint8_t buf[56];
+    ds1307_event_t all[DS1307_EVENT_MAX_ENTRY];
+    uint8_t count;
+    
+    if (DS1307_CHECK(event == NULL))                                               /* check event */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (DS1307_CHECK(event->inited != 1))                                          /* check event initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (DS1307_CHECK((events == NULL) || (len == NULL)))                           /* check events and len */
+    {
+        DS1307_LOG(event->handle, DS1307_LOG_EVENTS_IS_NULL, 0);                   /* events is null */
+        
+        return 2;                                                                  /* return error */
+    }
+    
+    if (ds1307_read_ram(event->handle, event->addr, buf, event->len) != 0)         /* read the region */
+    {
+        DS1307_LOG(event->handle, DS1307_LOG_READ_RAM_FAILED, 0);                  /* read ram failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    count = a_ds1307_event_decode(event, buf, all);                                /* decode */
+    if (*len > count)                                                              /* check length */
+    {
+        *len = count;                                                              /* set length */
+    }
+    memcpy(events, &all[count - *len], sizeof(ds1307_event_t) * (*len));           /* copy the newest */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     clear the event ring
+ * @param[in] *event pointer to a ds1307 event handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 event is NULL
+ *            - 3 event is not initialized
+ * @note      only the head byte is written
+ */
+uint8_t ds1307_event_clear(ds1307_event_handle_t *event)
+{
+    uint8_t head;
+    
+    if (DS1307_CHECK(event == NULL))                                                     /* check event */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (DS1307_CHECK(event->inited != 1))                                                /* check event initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    head = 0;                                                                            /* empty ring */
+    if (ds1307_write_ram(event->handle, (uint8_t)(event->addr + DS1307_EVENT_HEADER_SIZE - 1),
+                         &head, 1) != 0)                                                 /* write the head */
+    {
+        DS1307_LOG(event->handle, DS1307_LOG_WRITE_RAM_FAILED, 0);                       /* write ram failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    event->head = 0;                                                                     /* clear head */
+    event->wrapped = 0;                                                                  /* clear wrapped */
+    
+    return 0;                                                                            /* success return 0 */
+}
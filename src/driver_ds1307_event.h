@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_event.h
+ * @brief     driver ds1307 event header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1307_EVENT_H
+#define DRIVER_DS1307_EVENT_H
+
+#include "driver_ds1307.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds1307_event_driver ds1307 event driver function
+ * @brief    ds1307 event driver modules
+ * @ingroup  ds1307_driver
+ * @{
+ */
+
+/**
+ * @brief ds1307 event layout definition
+ * @note  the region starts with a magic byte, a 4 byte base epoch and a 1 byte head, followed by
+ *        entries of one code byte and a 24 bit second delta from the base
+ */
+#define DS1307_EVENT_MAGIC              0xE7             /**< header magic */
+#define DS1307_EVENT_HEADER_SIZE        6                /**< header size in bytes */
+#define DS1307_EVENT_ENTRY_SIZE         4                /**< entry size in bytes */
+#define DS1307_EVENT_MAX_DELTA          0xFFFFFFUL       /**< max delta from the base epoch */
+
+/**
+ * @brief ds1307 event structure definition
+ */
+typedef struct ds1307_event_s
+{
+    uint32_t epoch;        /**< unix timestamp */
+    uint8_t code;          /**< event code */
+} ds1307_event_t;
+
+/**
+ * @brief ds1307 event handle structure definition
+ */
+typedef struct ds1307_event_handle_s
+{
+    ds1307_handle_t *handle;        /**< ds1307 handle */
+    uint8_t addr;                   /**< ram region address */
+    uint8_t len;                    /**< ram region length */
+    uint8_t capacity;               /**< max entries */
+    uint8_t head;                   /**< next entry */
+    uint8_t wrapped;                /**< wrapped flag */
+    uint32_t base;                  /**< base epoch */
+    uint8_t inited;                 /**< inited flag */
+} ds1307_event_handle_t;
+
+/**
+ * @brief     init the event ring
+ * @param[in] *event pointer to a ds1307 event handle structure
+ * @param[in] *handle pointer to an initialized ds1307 handle structure
+ * @param[in] addr ram region address
+ * @param[in] len ram region length
+ * @return    status code
+ *            - 0 success
+ *            - 1 read ram failed
+ *            - 2 event or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is invalid
+ * @note      only the header is read, a header with a wrong magic or head is rewritten as an empty ring
+ */
+uint8_t ds1307_event_init(ds1307_event_handle_t *event, ds1307_handle_t *handle, uint8_t addr, uint8_t len);
+
+/**
+ * @brief     close the event ring
+ * @param[in] *event pointer to a ds1307 event handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 event is NULL
+ *            - 3 event is not initialized
+ * @note      none
+ */
+uint8_t ds1307_event_deinit(ds1307_event_handle_t *event);
+
+/**
+ * @brief     append an event stamped with the current time
+ * @param[in] *event pointer to a ds1307 event handle structure
+ * @param[in] code event code
+ * @return    status code
+ *            - 0 success
+ *            - 1 append failed
+ *            - 2 event is NULL
+ *            - 3 event is not initialized
+ * @note      an append writes the entry and then the head byte, the ring is only
+ *            rebased in one burst when the delta no longer fits 24 bits
+ */
+uint8_t ds1307_event_append(ds1307_event_handle_t *event, uint8_t code);
+
+/**
+ * @brief         read the events
+ * @param[in]     *event pointer to a ds1307 event handle structure
+ * @param[out]    *events pointer to an event buffer
+ * @param[in,out] *len pointer to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read ram failed
+ *                - 2 event is NULL
+ *                - 3 event is not initialized
+ * @note          the ring is read in one burst, the newest *len events are returned oldest first
+ */
+uint8_t ds1307_event_read(ds1307_event_handle_t *event, ds1307_event_t *events, uint8_t *len);
+
+/**
+ * @brief     clear the event ring
+ * @param[in] *event pointer to a ds1307 event handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 event is NULL
+ *            - 3 event is not initialized
+ * @note      only the head byte is written
+ */
+uint8_t ds1307_event_clear(ds1307_event_handle_t *event);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,468 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_kv.c
+ * @brief     driver ds1307 kv source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1307_kv.h"
+
+/**
+ * @brief kv pair empty definition
+ */
+#define DS1307_KV_NONE        0xFF        /**< no pair or no valid record */
+
+/**
+ * @brief     calculate the crc8 of a record
+ * @param[in] *buf pointer to a record
+ * @return    crc8
+ * @note      polynomial 0x31, init 0xFF, erased zero records never pass
+ */
+static uint8_t a_ds1307_kv_crc8(uint8_t *buf)
+{
+    uint8_t crc;
+    uint8_t i;
+    uint8_t j;
+    
+    crc = 0xFF;                                                          /* init crc */
+    for (i = 0; i < DS1307_KV_RECORD_SIZE - 1; i++)                      /* all bytes but the crc */
+    {
+        crc ^= buf[i];                                                   /* xor byte */
+        for (j = 0; j < 8; j++)                                          /* 8 bits */
+        {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);        /* shift */
+        }
+    }
+    
+    return crc;                                                          /* return crc */
+}
+
+/**
+ * @brief     check whether a sequence is newer
+ * @param[in] a checked sequence
+ * @param[in] b reference sequence
+ * @return    1 if a is newer than b, otherwise 0
+ * @note      sequences wrap at 256
+ */
+static uint8_t a_ds1307_kv_newer(uint8_t a, uint8_t b)
+{
+    uint8_t diff;
+    
+    diff = (uint8_t)(a - b);                                             /* wrapped distance */
+    
+    return ((diff != 0) && (diff < 128)) ? 1 : 0;                        /* return result */
+}
+
+/**
+ * @brief      build a record
+ * @param[out] *buf pointer to a record buffer
+ * @param[in]  key key
+ * @param[in]  seq sequence
+ * @param[in]  value value
+ * @note       none
+ */
+static void a_ds1307_kv_record(uint8_t *buf, uint8_t key, uint8_t seq, uint32_t value)
+{
+    buf[0] = key;                                                        /* set key */
+    buf[1] = seq;                                                        /* set sequence */
+    buf[2] = (uint8_t)(value >> 0);                                      /* set value */
+    buf[3] = (uint8_t)(value >> 8);                                      /* set value */
+    buf[4] = (uint8_t)(value >> 16);                                     /* set value */
+    buf[5] = (uint8_t)(value >> 24);                                     /* set value */
+    buf[6] = a_ds1307_kv_crc8(buf);                                      /* set crc */
+}
+
+/**
+ * @brief     write the older record of a pair
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @param[in] p pair index
+ * @param[in] key key
+ * @param[in] value value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the newer record stays intact until the write has completed
+ */
+static uint8_t a_ds1307_kv_commit(ds1307_kv_handle_t *kv, uint8_t p, uint8_t key, uint32_t value)
+{
+    uint8_t buf[DS1307_KV_RECORD_SIZE];
+    uint8_t slot;
+    uint8_t seq;
+    
+    slot = (kv->slot[p] == DS1307_KV_NONE) ? 0 : (uint8_t)(kv->slot[p] ^ 1);                  /* older record */
+    seq = (uint8_t)(kv->seq[p] + 1);                                                          /* next sequence */
+    a_ds1307_kv_record(buf, key, seq, value);                                                 /* build record */
+    if (ds1307_write_ram(kv->handle, (uint8_t)(kv->addr + (2 * p + slot) * DS1307_KV_RECORD_SIZE),
+                         buf, DS1307_KV_RECORD_SIZE) != 0)                                    /* write record */
+    {
+        return 1;                                                                             /* return error */
+    }
+    kv->slot[p] = slot;                                                                       /* set newest record */
+    kv->seq[p] = seq;                                                                         /* set sequence */
+    kv->key[p] = key;                                                                         /* set key */
+    kv->value[p] = value;                                                                     /* set value */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     init the kv store
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @param[in] *handle pointer to an initialized ds1307 handle structure
+ * @param[in] addr ram region address
+ * @param[in] len ram region length
+ * @return    status code
+ *            - 0 success
+ *            - 1 read ram failed
+ *            - 2 kv or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is invalid
+ * @note      the region is read once in one burst and indexed in memory
+ */
+uint8_t ds1307_kv_init(ds1307_kv_handle_t *kv, ds1307_handle_t *handle, uint8_t addr, uint8_t len)
+{
+    uint8_t buf[56];
+    uint8_t *rec;
+    uint8_t valid[2];
+    uint8_t p;
+    uint8_t s;
+    uint8_t n;
+    
+    if (DS1307_CHECK((kv == NULL) || (handle == NULL)))                                       /* check kv and handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (DS1307_CHECK(handle->inited != 1))                                                    /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if ((len < 2 * DS1307_KV_RECORD_SIZE) || ((uint16_t)addr + len > 56))                     /* check region */
+    {
+        DS1307_LOG(handle, DS1307_LOG_REGION_IS_INVALID, 0);                                  /* region is invalid */
+        
+        return 4;                                                                             /* return error */
+    }
+    
+    if (ds1307_read_ram(handle, addr, buf, len) != 0)                                         /* read the region */
+    {
+        DS1307_LOG(handle, DS1307_LOG_READ_RAM_FAILED, 0);                                    /* read ram failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    kv->handle = handle;                                                                      /* set handle */
+    kv->addr = addr;                                                                          /* set address */
+    kv->len = len;                                                                            /* set length */
+    kv->pair = (uint8_t)(len / (2 * DS1307_KV_RECORD_SIZE));                                  /* set pairs */
+    memset(kv->index, DS1307_KV_NONE, sizeof(kv->index));                                     /* clear index */
+    for (p = 0; p < kv->pair; p++)                                                            /* scan pairs */
+    {
+        for (s = 0; s < 2; s++)                                                               /* both records */
+        {
+            rec = &buf[(2 * p + s) * DS1307_KV_RECORD_SIZE];                                  /* record */
+            valid[s] = (a_ds1307_kv_crc8(rec) == rec[DS1307_KV_RECORD_SIZE - 1]) ? 1 : 0;     /* check crc */
+        }
+        if ((valid[0] != 0) && (valid[1] != 0))                                               /* both valid */
+        {
+            n = a_ds1307_kv_newer(buf[(2 * p + 1) * DS1307_KV_RECORD_SIZE + 1],
+                                  buf[(2 * p) * DS1307_KV_RECORD_SIZE + 1]);                  /* pick the newer */
+        }
+        else if (valid[0] != 0)                                                               /* first valid */
+        {
+            n = 0;                                                                            /* first record */
+        }
+        else if (valid[1] != 0)                                                               /* second valid */
+        {
+            n = 1;                                                                            /* second record */
+        }
+        else
+        {
+            n = DS1307_KV_NONE;                                                               /* no record */
+        }
+        kv->slot[p] = n;                                                                      /* set newest record */
+        if (n == DS1307_KV_NONE)                                                              /* check empty */
+        {
+            kv->key[p] = 0;                                                                   /* free pair */
+            kv->seq[p] = 0;                                                                   /* clear sequence */
+            kv->value[p] = 0;                                                                 /* clear value */
+            
+            continue;                                                                         /* next pair */
+        }
+        rec = &buf[(2 * p + n) * DS1307_KV_RECORD_SIZE];                                      /* newest record */
+        kv->key[p] = rec[0];                                                                  /* set key */
+        kv->seq[p] = rec[1];                                                                  /* set sequence */
+        kv->value[p] = (uint32_t)rec[2] | ((uint32_t)rec[3] << 8) |
+                       ((uint32_t)rec[4] << 16) | ((uint32_t)rec[5] << 24);                   /* set value */
+        if ((rec[0] != 0) && (kv->index[rec[0]] == DS1307_KV_NONE))                           /* first live key */
+        {
+            kv->index[rec[0]] = p;                                                            /* index the key */
+        }
+        else
+        {
+            kv->key[p] = 0;                                                                   /* free pair */
+        }
+    }
+    kv->inited = 1;                                                                           /* flag finish initialization */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     close the kv store
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 kv is NULL
+ *            - 3 kv is not initialized
+ * @note      none
+ */
+uint8_t ds1307_kv_deinit(ds1307_kv_handle_t *kv)
+{
+    if (DS1307_CHECK(kv == NULL))                     /* check kv */
+    {
+        return 2;                                     /* return error */
+    }
+    if (DS1307_CHECK(kv->inited != 1))                /* check kv initialization */
+    {
+        return 3;                                     /* return error */
+    }
+    
+    kv->inited = 0;                                   /* flag close */
+    
+    return 0;                                         /* success return 0 */
+}
+
+/**
+ * @brief      get a value
+ * @param[in]  *kv pointer to a ds1307 kv handle structure
+ * @param[in]  key key
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 kv is NULL
+ *             - 3 kv is not initialized
+ *             - 4 key is invalid
+ *             - 5 key is not found
+ * @note       key 0 is reserved, the value comes from the index without bus access
+ */
+uint8_t ds1307_kv_get(ds1307_kv_handle_t *kv, uint8_t key, uint32_t *value)
+{
+    uint8_t p;
+    
+    if (DS1307_CHECK(kv == NULL))                                     /* check kv */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (DS1307_CHECK(kv->inited != 1))                                /* check kv initialization */
+    {
+        return 3;                                                     /* return error */
+    }
+    if (DS1307_CHECK(value == NULL))                                  /* check value */
+    {
+        DS1307_LOG(kv->handle, DS1307_LOG_VALUE_IS_NULL, 0);          /* value is null */
+        
+        return 2;                                                     /* return error */
+    }
+    if (key == 0)                                                     /* check key */
+    {
+        DS1307_LOG(kv->handle, DS1307_LOG_KEY_IS_INVALID, 0);         /* key is invalid */
+        
+        return 4;                                                     /* return error */
+    }
+    
+    p = kv->index[key];                                               /* look up the pair */
+    if (p == DS1307_KV_NONE)                                          /* check pair */
+    {
+        return 5;                                                     /* return error */
+    }
+    *value = kv->value[p];                                            /* get value */
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief     set a value
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @param[in] key key
+ * @param[in] value value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not initialized
+ *            - 4 key is invalid
+ *            - 5 kv is full
+ * @note      only the older record of the key is written, an unchanged value writes nothing
+ */
+uint8_t ds1307_kv_set(ds1307_kv_handle_t *kv, uint8_t key, uint32_t value)
+{
+    uint8_t p;
+    
+    if (DS1307_CHECK(kv == NULL))                                     /* check kv */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (DS1307_CHECK(kv->inited != 1))                                /* check kv initialization */
+    {
+        return 3;                                                     /* return error */
+    }
+    if (key == 0)                                                     /* check key */
+    {
+        DS1307_LOG(kv->handle, DS1307_LOG_KEY_IS_INVALID, 0);         /* key is invalid */
+        
+        return 4;                                                     /* return error */
+    }
+    
+    p = kv->index[key];                                               /* look up the pair */
+    if (p != DS1307_KV_NONE)                                          /* check pair */
+    {
+        if (kv->value[p] == value)                                    /* check unchanged */
+        {
+            return 0;                                                 /* success return 0 */
+        }
+    }
+    else
+    {
+        for (p = 0; p < kv->pair; p++)                                /* find a free pair */
+        {
+            if (kv->key[p] == 0)                                      /* check free */
+            {
+                break;                                                /* break */
+            }
+        }
+        if (p == kv->pair)                                            /* check full */
+        {
+            DS1307_LOG(kv->handle, DS1307_LOG_KV_IS_FULL, 0);         /* kv is full */
+            
+            return 5;                                                 /* return error */
+        }
+    }
+    if (a_ds1307_kv_commit(kv, p, key, value) != 0)                   /* commit the record */
+    {
+        DS1307_LOG(kv->handle, DS1307_LOG_WRITE_RAM_FAILED, 0);       /* write ram failed */
+        
+        return 1;                                                     /* return error */
+    }
+    kv->index[key] = p;                                               /* index the key */
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief     delete a value
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @param[in] key key
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not initialized
+ *            - 4 key is invalid
+ *            - 5 key is not found
+ * @note      a newer record with key 0 frees the pair
+ */
+uint8_t ds1307_kv_delete(ds1307_kv_handle_t *kv, uint8_t key)
+{
+    uint8_t p;
+    
+    if (DS1307_CHECK(kv == NULL))                                     /* check kv */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (DS1307_CHECK(kv->inited != 1))                                /* check kv initialization */
+    {
+        return 3;                                                     /* return error */
+    }
+    if (key == 0)                                                     /* check key */
+    {
+        DS1307_LOG(kv->handle, DS1307_LOG_KEY_IS_INVALID, 0);         /* key is invalid */
+        
+        return 4;                                                     /* return error */
+    }
+    
+    p = kv->index[key];                                               /* look up the pair */
+    if (p == DS1307_KV_NONE)                                          /* check pair */
+    {
+        return 5;                                                     /* return error */
+    }
+    if (a_ds1307_kv_commit(kv, p, 0, 0) != 0)                         /* commit a free record */
+    {
+        DS1307_LOG(kv->handle, DS1307_LOG_WRITE_RAM_FAILED, 0);       /* write ram failed */
+        
+        return 1;                                                     /* return error */
+    }
+    kv->index[key] = DS1307_KV_NONE;                                  /* drop the key */
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief     erase the kv store
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not initialized
+ * @note      none
+ */
+uint8_t ds1307_kv_format(ds1307_kv_handle_t *kv)
+{
+    uint8_t buf[56];
+    uint8_t p;
+    
+    if (DS1307_CHECK(kv == NULL))                                     /* check kv */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (DS1307_CHECK(kv->inited != 1))                                /* check kv initialization */
+    {
+        return 3;                                                     /* return error */
+    }
+    
+    memset(buf, 0, sizeof(buf));                                      /* clear buffer */
+    if (ds1307_write_ram(kv->handle, kv->addr, buf, kv->len) != 0)    /* erase the region */
+    {
+        DS1307_LOG(kv->handle, DS1307_LOG_WRITE_RAM_FAILED, 0);       /* write ram failed */
+        
+        return 1;                                                     /* return error */
+    }
+    memset(kv->index, DS1307_KV_NONE, sizeof(kv->index));             /* clear index */
+    for (p = 0; p < kv->pair; p++)                                    /* all pairs */
+    {
+        kv->key[p] = 0;                                               /* free pair */
+        kv->slot[p] = DS1307_KV_NONE;                                 /* no record */
+        kv->seq[p] = 0;                                               /* clear sequence */
+        kv->value[p] = 0;                                             /* clear value */
+    }
+    
+    return 0;                                                         /* success return 0 */
+}
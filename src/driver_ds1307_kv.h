@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_kv.h
+ * @brief     driver ds1307 kv header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1307_KV_H
+#define DRIVER_DS1307_KV_H
+
+#include "driver_ds1307.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds1307_kv_driver ds1307 kv driver function
+ * @brief    ds1307 kv driver modules
+ * @ingroup  ds1307_driver
+ * @{
+ */
+
+/**
+ * @brief ds1307 kv record definition
+ * @note  a record is key, sequence, 4 value bytes and crc8, every key owns two records
+ *        and a commit always overwrites the older one
+ */
+#define DS1307_KV_RECORD_SIZE        7                                    /**< record size in bytes */
+#define DS1307_KV_MAX_PAIR           (56 / (2 * DS1307_KV_RECORD_SIZE))   /**< max record pairs */
+
+/**
+ * @brief ds1307 kv handle structure definition
+ */
+typedef struct ds1307_kv_handle_s
+{
+    ds1307_handle_t *handle;                        /**< ds1307 handle */
+    uint8_t addr;                                   /**< ram region address */
+    uint8_t len;                                    /**< ram region length */
+    uint8_t pair;                                   /**< record pairs in the region */
+    uint8_t key[DS1307_KV_MAX_PAIR];                /**< live key of each pair */
+    uint8_t slot[DS1307_KV_MAX_PAIR];               /**< newest valid record of each pair */
+    uint8_t seq[DS1307_KV_MAX_PAIR];                /**< newest sequence of each pair */
+    uint32_t value[DS1307_KV_MAX_PAIR];             /**< value of each pair */
+    uint8_t index[256];                             /**< key to pair index */
+    uint8_t inited;                                 /**< inited flag */
+} ds1307_kv_handle_t;
+
+/**
+ * @brief     init the kv store
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @param[in] *handle pointer to an initialized ds1307 handle structure
+ * @param[in] addr ram region address
+ * @param[in] len ram region length
+ * @return    status code
+ *            - 0 success
+ *            - 1 read ram failed
+ *            - 2 kv or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is invalid
+ * @note      the region is read once in one burst and indexed in memory
+ */
+uint8_t ds1307_kv_init(ds1307_kv_handle_t *kv, ds1307_handle_t *handle, uint8_t addr, uint8_t len);
+
+/**
+ * @brief     close the kv store
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 kv is NULL
+ *            - 3 kv is not initialized
+ * @note      none
+ */
+uint8_t ds1307_kv_deinit(ds1307_kv_handle_t *kv);
+
+/**
+ * @brief      get a value
+ * @param[in]  *kv pointer to a ds1307 kv handle structure
+ * @param[in]  key key
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 kv is NULL
+ *             - 3 kv is not initialized
+ *             - 4 key is invalid
+ *             - 5 key is not found
+ * @note       key 0 is reserved, the value comes from the index without bus access
+ */
+uint8_t ds1307_kv_get(ds1307_kv_handle_t *kv, uint8_t key, uint32_t *value);
+
+/**
+ * @brief     set a value
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @param[in] key key
+ * @param[in] value value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not initialized
+ *            - 4 key is invalid
+ *            - 5 kv is full
+ * @note      only the older record of the key is written, an unchanged value writes nothing
+ */
+uint8_t ds1307_kv_set(ds1307_kv_handle_t *kv, uint8_t key, uint32_t value);
+
+/**
+ * @brief     delete a value
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @param[in] key key
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not initialized
+ *            - 4 key is invalid
+ *            - 5 key is not found
+ * @note      a newer record with key 0 frees the pair
+ */
+uint8_t ds1307_kv_delete(ds1307_kv_handle_t *kv, uint8_t key);
+
+/**
+ * @brief     erase the kv store
+ * @param[in] *kv pointer to a ds1307 kv handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write ram failed
+ *            - 2 kv is NULL
+ *            - 3 kv is not initialized
+ * @note      none
+ */
+uint8_t ds1307_kv_format(ds1307_kv_handle_t *kv);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
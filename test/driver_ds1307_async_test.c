@@ -0,0 +1,443 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_async_test.c
+ * @brief     driver ds1307 async test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1307_async_test.h"
+#include <stdlib.h>
+
+static ds1307_handle_t gs_handle;        /**< ds1307 handle */
+static volatile uint8_t gs_done;         /**< done flag */
+static volatile uint8_t gs_res;          /**< async result */
+static uint8_t gs_buf[56];               /**< write buffer */
+static uint8_t gs_buf_check[56];         /**< read buffer */
+
+/**
+ * @brief     async callback
+ * @param[in] *handle pointer to a ds1307 handle structure
+ * @param[in] res async result
+ * @param[in] *arg callback argument
+ * @note      none
+ */
+static void a_async_callback(ds1307_handle_t *handle, uint8_t res, void *arg)
+{
+    (void)handle;
+    (void)arg;
+    
+    gs_res = res;
+    gs_done = 1;
+}
+
+/**
+ * @brief  wait for the async operation
+ * @return status code
+ *         - 0 success
+ *         - 1 async failed
+ * @note   none
+ */
+static uint8_t a_async_wait(void)
+{
+    uint32_t timeout;
+    
+    timeout = 1000;
+    while ((gs_done == 0) && (timeout != 0))
+    {
+        ds1307_interface_delay_ms(1);
+        timeout--;
+    }
+    if (gs_done == 0)
+    {
+        ds1307_interface_debug_print("ds1307: async timeout.\n");
+        
+        return 1;
+    }
+    
+    return gs_res;
+}
+
+/**
+ * @brief  async test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t ds1307_async_test(void)
+{
+    uint8_t res;
+    uint8_t i;
+    ds1307_info_t info;
+    ds1307_time_t time_in;
+    ds1307_time_t time_out;
+    ds1307_bool_t enable;
+    ds1307_bool_t busy;
+    ds1307_output_level_t level;
+    ds1307_output_mode_t mode;
+    ds1307_square_wave_frequency_t freq;
+    
+    /* link functions */
+    DRIVER_DS1307_LINK_INIT(&gs_handle, ds1307_handle_t);
+    DRIVER_DS1307_LINK_IIC_INIT(&gs_handle, ds1307_interface_iic_init);
+    DRIVER_DS1307_LINK_IIC_DEINIT(&gs_handle, ds1307_interface_iic_deinit);
+    DRIVER_DS1307_LINK_IIC_READ(&gs_handle, ds1307_interface_iic_read);
+    DRIVER_DS1307_LINK_IIC_WRITE(&gs_handle, ds1307_interface_iic_write);
+    DRIVER_DS1307_LINK_IIC_READ_ASYNC(&gs_handle, ds1307_interface_iic_read_async);
+    DRIVER_DS1307_LINK_IIC_WRITE_ASYNC(&gs_handle, ds1307_interface_iic_write_async);
+    DRIVER_DS1307_LINK_DELAY_MS(&gs_handle, ds1307_interface_delay_ms);
+    DRIVER_DS1307_LINK_GET_TICK_NS(&gs_handle, ds1307_interface_get_tick_ns);
+    DRIVER_DS1307_LINK_STATS_TICK(&gs_handle, ds1307_interface_stats_tick);
+    DRIVER_DS1307_LINK_TRACE(&gs_handle, ds1307_interface_trace);
+    DRIVER_DS1307_LINK_DEBUG_PRINT(&gs_handle, ds1307_interface_debug_print);
+    
+    /* get ds1307 info */
+    res = ds1307_info(&info);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get info failed.\n");
+       
+        return 1;
+    }
+    else
+    {
+        /* print ds1307 info */
+        ds1307_interface_debug_print("ds1307: chip is %s.\n", info.chip_name);
+        ds1307_interface_debug_print("ds1307: manufacturer is %s.\n", info.manufacturer_name);
+        ds1307_interface_debug_print("ds1307: interface is %s.\n", info.interface);
+        ds1307_interface_debug_print("ds1307: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        ds1307_interface_debug_print("ds1307: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        ds1307_interface_debug_print("ds1307: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        ds1307_interface_debug_print("ds1307: max current is %0.2fmA.\n", info.max_current_ma);
+        ds1307_interface_debug_print("ds1307: max temperature is %0.1fC.\n", info.temperature_max);
+        ds1307_interface_debug_print("ds1307: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start async test */
+    ds1307_interface_debug_print("ds1307: start async test.\n");
+    
+    /* init ds1307 */
+    res = ds1307_init(&gs_handle);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* ds1307_set_oscillator_async test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_oscillator_async test.\n");
+    
+    /* enable the oscillator */
+    gs_done = 0;
+    res = ds1307_set_oscillator_async(&gs_handle, DS1307_BOOL_TRUE, a_async_callback, NULL);
+    if ((res != 0) || (a_async_wait() != 0))
+    {
+        ds1307_interface_debug_print("ds1307: set oscillator async failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_oscillator(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get oscillator failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check oscillator %s.\n", (enable == DS1307_BOOL_TRUE) ? "ok" : "error");
+    if (enable != DS1307_BOOL_TRUE)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* ds1307_set_time_async/ds1307_get_time_async test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_time_async/ds1307_get_time_async test.\n");
+    
+    time_in.format = DS1307_FORMAT_24H;
+    time_in.am_pm = DS1307_AM;
+    time_in.year = rand() % 100 + 2000;
+    time_in.month = rand() % 12 + 1;
+    time_in.date = rand() % 20 + 1;
+    time_in.week = rand() % 7 + 1;
+    time_in.hour = rand() % 24;
+    time_in.minute = rand() % 60;
+    time_in.second = rand() % 50;
+    ds1307_interface_debug_print("ds1307: set time %04d-%02d-%02d %02d:%02d:%02d %d.\n",
+                                 time_in.year, time_in.month, time_in.date,
+                                 time_in.hour, time_in.minute, time_in.second, time_in.week
+                                );
+    gs_done = 0;
+    res = ds1307_set_time_async(&gs_handle, &time_in, a_async_callback, NULL);
+    if ((res != 0) || (a_async_wait() != 0))
+    {
+        ds1307_interface_debug_print("ds1307: set time async failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_done = 0;
+    res = ds1307_get_time_async(&gs_handle, &time_out, a_async_callback, NULL);
+    if ((res != 0) || (a_async_wait() != 0))
+    {
+        ds1307_interface_debug_print("ds1307: get time async failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: get time %04d-%02d-%02d %02d:%02d:%02d %d.\n",
+                                 time_out.year, time_out.month, time_out.date,
+                                 time_out.hour, time_out.minute, time_out.second, time_out.week
+                                );
+    if ((time_out.year != time_in.year) || (time_out.month != time_in.month) ||
+        (time_out.date != time_in.date) || (time_out.week != time_in.week) ||
+        (time_out.hour != time_in.hour) || (time_out.minute != time_in.minute) ||
+        (time_out.second < time_in.second) || (time_out.second > time_in.second + 2))
+    {
+        ds1307_interface_debug_print("ds1307: check time error.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check time ok.\n");
+    
+    /* the async read refreshes the time cache */
+    res = ds1307_set_time_cache(&gs_handle, DS1307_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set time cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_set_time_cache_interval(&gs_handle, 60000);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set time cache interval failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_done = 0;
+    res = ds1307_get_time_async(&gs_handle, &time_out, a_async_callback, NULL);
+    if ((res != 0) || (a_async_wait() != 0))
+    {
+        ds1307_interface_debug_print("ds1307: get time async failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* move the chip minute behind the driver */
+    i = (uint8_t)((time_out.minute + 30) % 60);
+    i = (uint8_t)(((i / 10) << 4) | (i % 10));
+    res = ds1307_interface_iic_write(0xD0, 0x01, &i, 1);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: iic write failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_time(&gs_handle, &time_in);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check async time cache %s.\n", (time_in.minute == time_out.minute) ? "ok" : "error");
+    if (time_in.minute != time_out.minute)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_set_time_cache(&gs_handle, DS1307_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set time cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* ds1307_write_ram_async/ds1307_read_ram_async test */
+    ds1307_interface_debug_print("ds1307: ds1307_write_ram_async/ds1307_read_ram_async test.\n");
+    
+    for (i = 0; i < 56; i++)
+    {
+        gs_buf[i] = rand() & 0xFF;
+    }
+    gs_done = 0;
+    res = ds1307_write_ram_async(&gs_handle, 0, gs_buf, 56, a_async_callback, NULL);
+    if ((res != 0) || (a_async_wait() != 0))
+    {
+        ds1307_interface_debug_print("ds1307: write ram async failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_done = 0;
+    res = ds1307_read_ram_async(&gs_handle, 0, gs_buf_check, 56, a_async_callback, NULL);
+    if ((res != 0) || (a_async_wait() != 0))
+    {
+        ds1307_interface_debug_print("ds1307: read ram async failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < 56; i++)
+    {
+        if (gs_buf[i] != gs_buf_check[i])
+        {
+            ds1307_interface_debug_print("ds1307: check ram error.\n");
+            (void)ds1307_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    ds1307_interface_debug_print("ds1307: check ram ok.\n");
+    
+    /* ds1307_set_output_mode_async test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_output_mode_async test.\n");
+    
+    gs_done = 0;
+    res = ds1307_set_output_mode_async(&gs_handle, DS1307_OUTPUT_MODE_LEVEL, a_async_callback, NULL);
+    if ((res != 0) || (a_async_wait() != 0))
+    {
+        ds1307_interface_debug_print("ds1307: set output mode async failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_output_mode(&gs_handle, &mode);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get output mode failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check output mode %s.\n", (mode == DS1307_OUTPUT_MODE_LEVEL) ? "ok" : "error");
+    if (mode != DS1307_OUTPUT_MODE_LEVEL)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* ds1307_set_output_level_async test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_output_level_async test.\n");
+    
+    gs_done = 0;
+    res = ds1307_set_output_level_async(&gs_handle, DS1307_OUTPUT_LEVEL_HIGH, a_async_callback, NULL);
+    if ((res != 0) || (a_async_wait() != 0))
+    {
+        ds1307_interface_debug_print("ds1307: set output level async failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_output_level(&gs_handle, &level);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get output level failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check output level %s.\n", (level == DS1307_OUTPUT_LEVEL_HIGH) ? "ok" : "error");
+    if (level != DS1307_OUTPUT_LEVEL_HIGH)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* ds1307_set_square_wave_frequency_async test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_square_wave_frequency_async test.\n");
+    
+    gs_done = 0;
+    res = ds1307_set_square_wave_frequency_async(&gs_handle, DS1307_SQUARE_WAVE_FREQUENCY_4096_HZ, a_async_callback, NULL);
+    if ((res != 0) || (a_async_wait() != 0))
+    {
+        ds1307_interface_debug_print("ds1307: set square wave frequency async failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_square_wave_frequency(&gs_handle, &freq);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get square wave frequency failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check square wave frequency %s.\n", (freq == DS1307_SQUARE_WAVE_FREQUENCY_4096_HZ) ? "ok" : "error");
+    if (freq != DS1307_SQUARE_WAVE_FREQUENCY_4096_HZ)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* ds1307_get_async_busy test */
+    ds1307_interface_debug_print("ds1307: ds1307_get_async_busy test.\n");
+    
+    res = ds1307_get_async_busy(&gs_handle, &busy);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get async busy failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check async busy %s.\n", (busy == DS1307_BOOL_FALSE) ? "ok" : "error");
+    if (busy != DS1307_BOOL_FALSE)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish async test */
+    ds1307_interface_debug_print("ds1307: finish async test.\n");
+    (void)ds1307_deinit(&gs_handle);
+    
+    return 0;
+}
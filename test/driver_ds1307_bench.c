@@ -0,0 +1,332 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_bench.c
+ * @brief     driver ds1307 bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1307_bench.h"
+#include "driver_ds1307_emulator.h"
+#include <stdlib.h>
+
+/**
+ * @brief bench operation enumeration definition
+ */
+typedef enum
+{
+    DS1307_BENCH_GET_TIME                  = 0x00,        /**< ds1307_get_time */
+    DS1307_BENCH_SET_TIME                  = 0x01,        /**< ds1307_set_time */
+    DS1307_BENCH_READ_RAM                  = 0x02,        /**< ds1307_read_ram */
+    DS1307_BENCH_WRITE_RAM                 = 0x03,        /**< ds1307_write_ram */
+    DS1307_BENCH_SET_OUTPUT_LEVEL          = 0x04,        /**< ds1307_set_output_level */
+    DS1307_BENCH_SET_OUTPUT_MODE           = 0x05,        /**< ds1307_set_output_mode */
+    DS1307_BENCH_SET_SQUARE_WAVE_FREQUENCY = 0x06,        /**< ds1307_set_square_wave_frequency */
+    DS1307_BENCH_RAW_TIME_DECODE           = 0x07,        /**< ds1307_raw_time_decode */
+    DS1307_BENCH_TIME_CHECK                = 0x08,        /**< ds1307_set_time with an invalid time */
+    DS1307_BENCH_MAX                       = 0x09,        /**< operation number */
+} ds1307_bench_t;
+
+static ds1307_handle_t gs_handle;                                /**< ds1307 handle */
+static ds1307_raw_time_t gs_raw;                                 /**< raw time */
+static const char *const gs_name[DS1307_BENCH_MAX] =
+{
+    "get_time",
+    "set_time",
+    "read_ram",
+    "write_ram",
+    "set_output_level",
+    "set_output_mode",
+    "set_square_wave_frequency",
+    "raw_time_decode",
+    "time_check",
+};                                                               /**< operation name */
+
+/**
+ * @brief     silent debug print
+ * @param[in] fmt format data
+ * @note      drops the expected time check messages
+ */
+static void a_bench_silent_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     latency compare
+ * @param[in] *a pointer to a latency
+ * @param[in] *b pointer to a latency
+ * @return    compare result
+ * @note      none
+ */
+static int a_bench_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief     run one operation
+ * @param[in] op bench operation
+ * @param[in] i iteration
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_bench_run(ds1307_bench_t op, uint32_t i)
+{
+    ds1307_time_t t;
+    uint8_t buf[8];
+    
+    switch (op)
+    {
+        case DS1307_BENCH_GET_TIME :
+        {
+            return ds1307_get_time(&gs_handle, &t);
+        }
+        case DS1307_BENCH_SET_TIME :
+        {
+            t.format = DS1307_FORMAT_24H;
+            t.am_pm = DS1307_AM;
+            t.year = 2026;
+            t.month = 10;
+            t.date = 17;
+            t.week = 6;
+            t.hour = 12;
+            t.minute = (uint8_t)((i / 60) % 60);
+            t.second = (uint8_t)(i % 60);
+            
+            return ds1307_set_time(&gs_handle, &t);
+        }
+        case DS1307_BENCH_READ_RAM :
+        {
+            return ds1307_read_ram(&gs_handle, (uint8_t)(i % 48), buf, 8);
+        }
+        case DS1307_BENCH_WRITE_RAM :
+        {
+            memset(buf, (int)(i & 0xFF), 8);
+            
+            return ds1307_write_ram(&gs_handle, (uint8_t)(i % 48), buf, 8);
+        }
+        case DS1307_BENCH_SET_OUTPUT_LEVEL :
+        {
+            return ds1307_set_output_level(&gs_handle, (ds1307_output_level_t)(i & 0x01));
+        }
+        case DS1307_BENCH_SET_OUTPUT_MODE :
+        {
+            return ds1307_set_output_mode(&gs_handle, (ds1307_output_mode_t)(i & 0x01));
+        }
+        case DS1307_BENCH_SET_SQUARE_WAVE_FREQUENCY :
+        {
+            return ds1307_set_square_wave_frequency(&gs_handle, (ds1307_square_wave_frequency_t)(i & 0x03));
+        }
+        case DS1307_BENCH_RAW_TIME_DECODE :
+        {
+            gs_raw.reg[0] = (uint8_t)(i & 0x7F) % 0x60;
+            
+            return ds1307_raw_time_decode(&gs_raw, &t);
+        }
+        case DS1307_BENCH_TIME_CHECK :
+        {
+            t.format = (ds1307_format_t)(i & 0x01);
+            t.am_pm = DS1307_AM;
+            t.year = 2026;
+            t.month = 2;
+            t.date = 28;
+            t.week = 6;
+            t.hour = 11;
+            t.minute = 30;
+            t.second = 30;
+            switch (i % 4)
+            {
+                case 0 :
+                {
+                    t.date = 30;
+                    break;
+                }
+                case 1 :
+                {
+                    t.hour = 24;
+                    break;
+                }
+                case 2 :
+                {
+                    t.minute = 60;
+                    break;
+                }
+                default :
+                {
+                    t.year = 2100;
+                    break;
+                }
+            }
+            
+            return (uint8_t)(ds1307_set_time(&gs_handle, &t) != 4);
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief     bench
+ * @param[in] times iterations of every operation
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed
+ * @note      runs against the emulator and prints the result as json
+ */
+uint8_t ds1307_bench(uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t *lat;
+    uint64_t start;
+    uint64_t end;
+    uint64_t begin;
+    double ops;
+    ds1307_bench_t op;
+    
+    /* check the times */
+    if (times == 0)
+    {
+        ds1307_interface_debug_print("ds1307: times is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link functions */
+    DRIVER_DS1307_LINK_INIT(&gs_handle, ds1307_handle_t);
+    DRIVER_DS1307_LINK_IIC_INIT(&gs_handle, ds1307_emulator_iic_init);
+    DRIVER_DS1307_LINK_IIC_DEINIT(&gs_handle, ds1307_emulator_iic_deinit);
+    DRIVER_DS1307_LINK_IIC_READ(&gs_handle, ds1307_emulator_iic_read);
+    DRIVER_DS1307_LINK_IIC_WRITE(&gs_handle, ds1307_emulator_iic_write);
+    DRIVER_DS1307_LINK_DELAY_MS(&gs_handle, ds1307_interface_delay_ms);
+    DRIVER_DS1307_LINK_GET_TICK_NS(&gs_handle, ds1307_interface_get_tick_ns);
+    DRIVER_DS1307_LINK_STATS_TICK(&gs_handle, ds1307_interface_stats_tick);
+    DRIVER_DS1307_LINK_DEBUG_PRINT(&gs_handle, ds1307_interface_debug_print);
+    
+    /* latency buffer */
+    lat = (uint32_t *)malloc(sizeof(uint32_t) * times);
+    if (lat == NULL)
+    {
+        ds1307_interface_debug_print("ds1307: malloc failed.\n");
+        
+        return 1;
+    }
+    
+    /* init ds1307 */
+    (void)ds1307_emulator_reset();
+    res = ds1307_init(&gs_handle);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: init failed.\n");
+        free(lat);
+        
+        return 1;
+    }
+    res = ds1307_set_oscillator(&gs_handle, DS1307_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set oscillator failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        free(lat);
+        
+        return 1;
+    }
+    res = ds1307_get_raw_time(&gs_handle, &gs_raw);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get raw time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        free(lat);
+        
+        return 1;
+    }
+    
+    ds1307_interface_debug_print("{\n");
+    ds1307_interface_debug_print("  \"driver\": \"ds1307\",\n");
+    ds1307_interface_debug_print("  \"transport\": \"emulator\",\n");
+    ds1307_interface_debug_print("  \"iterations\": %u,\n", times);
+    ds1307_interface_debug_print("  \"results\": [\n");
+    for (op = DS1307_BENCH_GET_TIME; op < DS1307_BENCH_MAX; op++)
+    {
+        /* the time check prints every failing field */
+        if (op == DS1307_BENCH_TIME_CHECK)
+        {
+            DRIVER_DS1307_LINK_DEBUG_PRINT(&gs_handle, a_bench_silent_print);
+        }
+        
+        /* run */
+        begin = ds1307_interface_get_tick_ns();
+        for (i = 0; i < times; i++)
+        {
+            start = ds1307_interface_get_tick_ns();
+            res = a_bench_run(op, i);
+            end = ds1307_interface_get_tick_ns();
+            if (res != 0)
+            {
+                ds1307_interface_debug_print("ds1307: %s failed.\n", gs_name[op]);
+                (void)ds1307_deinit(&gs_handle);
+                free(lat);
+                
+                return 1;
+            }
+            lat[i] = (uint32_t)(end - start);
+        }
+        end = ds1307_interface_get_tick_ns();
+        DRIVER_DS1307_LINK_DEBUG_PRINT(&gs_handle, ds1307_interface_debug_print);
+        
+        /* report */
+        qsort(lat, times, sizeof(uint32_t), a_bench_compare);
+        ops = (end > begin) ? ((double)times * 1000000000.0 / (double)(end - begin)) : 0.0;
+        ds1307_interface_debug_print("    {\"name\": \"%s\", \"ops_per_sec\": %.0f, "
+                                     "\"p50_ns\": %u, \"p99_ns\": %u, \"p999_ns\": %u}%s\n",
+                                     gs_name[op], ops,
+                                     lat[(uint64_t)times * 500 / 1000],
+                                     lat[(uint64_t)times * 990 / 1000],
+                                     lat[(uint64_t)times * 999 / 1000],
+                                     (op + 1 < DS1307_BENCH_MAX) ? "," : "");
+    }
+    ds1307_interface_debug_print("  ]\n");
+    ds1307_interface_debug_print("}\n");
+    
+    /* finish */
+    (void)ds1307_deinit(&gs_handle);
+    free(lat);
+    
+    return 0;
+}
@@ -0,0 +1,683 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_emulator.c
+ * @brief     driver ds1307 emulator source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1307_emulator.h"
+
+/**
+ * @brief chip address definition
+ */
+#define DS1307_EMULATOR_ADDRESS        0xD0        /**< iic device address */
+
+/**
+ * @brief emulator constant definition
+ */
+#define DS1307_EMULATOR_SECOND_NS      1000000000ULL        /**< 1s in ns */
+#define DS1307_EMULATOR_START_NS       1000000000ULL        /**< virtual time after reset */
+
+static uint8_t gs_reg[64];                                                         /**< register file */
+static uint8_t gs_pointer;                                                         /**< register pointer */
+static uint8_t gs_attach;                                                          /**< attach flag */
+static ds1307_emulator_clock_t gs_clock;                                           /**< clock source */
+static uint64_t gs_virtual_ns;                                                     /**< virtual time */
+static uint64_t gs_last_ns;                                                        /**< time of the last update */
+static uint64_t gs_phase_ns;                                                       /**< countdown chain, ns into the second */
+static uint32_t gs_wire_hz;                                                        /**< wire speed */
+static int32_t gs_skew_ppm;                                                        /**< chain speed error */
+static uint8_t (*gs_sqw_callback)(void);                                           /**< sqw callback */
+static uint8_t gs_sqw_busy;                                                        /**< sqw callback running flag */
+static const uint8_t gs_mask[8] = {0xFF, 0x7F, 0x7F, 0x07, 0x3F, 0x1F, 0xFF, 0x93}; /**< writable bits */
+static const uint8_t gs_days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}; /**< days of a month */
+static const uint32_t gs_freq[4] = {1, 4096, 8192, 32768};                         /**< rs frequency */
+
+/**
+ * @brief     bcd to hex
+ * @param[in] val bcd value
+ * @return    hex value
+ * @note      none
+ */
+static uint8_t a_emulator_bcd2hex(uint8_t val)
+{
+    return (uint8_t)((val >> 4) * 10 + (val & 0x0F));
+}
+
+/**
+ * @brief     hex to bcd
+ * @param[in] val hex value
+ * @return    bcd value
+ * @note      none
+ */
+static uint8_t a_emulator_hex2bcd(uint8_t val)
+{
+    return (uint8_t)(((val / 10) << 4) | (val % 10));
+}
+
+/**
+ * @brief  get the current emulator time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_emulator_now(void)
+{
+    if (gs_clock == DS1307_EMULATOR_CLOCK_REAL)
+    {
+        return ds1307_interface_get_tick_ns();
+    }
+    
+    return gs_virtual_ns;
+}
+
+/**
+ * @brief     get the countdown chain time of an emulator time span
+ * @param[in] ns emulator time in ns
+ * @return    chain time in ns
+ * @note      the chain runs gs_skew_ppm faster than the emulator clock
+ */
+static uint64_t a_emulator_chain(uint64_t ns)
+{
+    return (uint64_t)((int64_t)ns + (int64_t)ns * gs_skew_ppm / 1000000);
+}
+
+/**
+ * @brief increment the hours, 12H or 24H
+ * @return 1 if the day rolled over, 0 if not
+ * @note   none
+ */
+static uint8_t a_emulator_tick_hour(void)
+{
+    uint8_t hour;
+    uint8_t pm;
+    
+    /* 12H */
+    if ((gs_reg[2] & (1 << 6)) != 0)
+    {
+        hour = a_emulator_bcd2hex(gs_reg[2] & 0x1F);
+        pm = (gs_reg[2] >> 5) & 0x01;
+        if (hour == 11)
+        {
+            /* 11 pm goes to 12 am of the next day */
+            gs_reg[2] = (uint8_t)((1 << 6) | ((pm ^ 1) << 5) | a_emulator_hex2bcd(12));
+            
+            return pm;
+        }
+        hour = (hour >= 12) ? 1 : (uint8_t)(hour + 1);
+        gs_reg[2] = (uint8_t)((1 << 6) | (pm << 5) | a_emulator_hex2bcd(hour));
+        
+        return 0;
+    }
+    
+    /* 24H */
+    hour = a_emulator_bcd2hex(gs_reg[2] & 0x3F);
+    if (hour >= 23)
+    {
+        gs_reg[2] = 0x00;
+        
+        return 1;
+    }
+    gs_reg[2] = a_emulator_hex2bcd((uint8_t)(hour + 1));
+    
+    return 0;
+}
+
+/**
+ * @brief increment the calendar by one day
+ * @note  the year is 2000 - 2099, so every year divisible by 4 is a leap year
+ */
+static void a_emulator_tick_day(void)
+{
+    uint8_t date;
+    uint8_t month;
+    uint8_t year;
+    uint8_t days;
+    
+    gs_reg[3] = (uint8_t)((gs_reg[3] & 0x07) >= 7 ? 1 : (gs_reg[3] & 0x07) + 1);
+    date = a_emulator_bcd2hex(gs_reg[4] & 0x3F);
+    month = a_emulator_bcd2hex(gs_reg[5] & 0x1F);
+    year = a_emulator_bcd2hex(gs_reg[6]);
+    days = ((month >= 1) && (month <= 12)) ? gs_days[month - 1] : 31;
+    if ((month == 2) && ((year % 4) == 0))
+    {
+        days = 29;
+    }
+    if (date < days)
+    {
+        gs_reg[4] = a_emulator_hex2bcd((uint8_t)(date + 1));
+        
+        return;
+    }
+    gs_reg[4] = 0x01;
+    if (month < 12)
+    {
+        gs_reg[5] = a_emulator_hex2bcd((uint8_t)(month + 1));
+        
+        return;
+    }
+    gs_reg[5] = 0x01;
+    gs_reg[6] = a_emulator_hex2bcd((uint8_t)((year + 1) % 100));
+}
+
+/**
+ * @brief increment the time by one second
+ * @note  none
+ */
+static void a_emulator_tick_second(void)
+{
+    uint8_t second;
+    uint8_t minute;
+    
+    second = a_emulator_bcd2hex(gs_reg[0] & 0x7F);
+    if (second < 59)
+    {
+        gs_reg[0] = a_emulator_hex2bcd((uint8_t)(second + 1));
+        
+        return;
+    }
+    gs_reg[0] = 0x00;
+    minute = a_emulator_bcd2hex(gs_reg[1] & 0x7F);
+    if (minute < 59)
+    {
+        gs_reg[1] = a_emulator_hex2bcd((uint8_t)(minute + 1));
+        
+        return;
+    }
+    gs_reg[1] = 0x00;
+    if (a_emulator_tick_hour() != 0)
+    {
+        a_emulator_tick_day();
+    }
+}
+
+/**
+ * @brief     run the countdown chain up to a time
+ * @param[in] now time in ns
+ * @note      a halted oscillator keeps the chain and the registers frozen
+ */
+static void a_emulator_update(uint64_t now)
+{
+    uint64_t elapsed;
+    
+    elapsed = (now > gs_last_ns) ? (now - gs_last_ns) : 0;
+    gs_last_ns = now;
+    if ((gs_reg[0] & 0x80) != 0)
+    {
+        return;
+    }
+    gs_phase_ns += a_emulator_chain(elapsed);
+    while (gs_phase_ns >= DS1307_EMULATOR_SECOND_NS)
+    {
+        gs_phase_ns -= DS1307_EMULATOR_SECOND_NS;
+        a_emulator_tick_second();
+    }
+}
+
+/**
+ * @brief      get the time to the next sqw falling edge
+ * @param[out] *ns pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no edge will come
+ * @note       edges sit at k * 1s / f in the countdown chain, rounded up so the
+ *             next search always moves past the current edge
+ */
+static uint8_t a_emulator_sqw_next(uint64_t *ns)
+{
+    uint32_t f;
+    uint64_t k;
+    uint64_t edge;
+    
+    if (((gs_reg[0] & 0x80) != 0) || ((gs_reg[7] & (1 << 4)) == 0))
+    {
+        return 1;
+    }
+    f = gs_freq[gs_reg[7] & 0x03];
+    k = gs_phase_ns * f / DS1307_EMULATOR_SECOND_NS + 1;
+    edge = (k * DS1307_EMULATOR_SECOND_NS + f - 1) / f;
+    *ns = (edge - gs_phase_ns) * 1000000 / (uint64_t)(1000000 + gs_skew_ppm);
+    while (a_emulator_chain(*ns) < edge - gs_phase_ns)
+    {
+        (*ns)++;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     let a transfer take its wire time
+ * @param[in] bits bit times of the transfer
+ * @note      none
+ */
+static void a_emulator_wire(uint32_t bits)
+{
+    uint64_t ns;
+    uint64_t end;
+    
+    if (gs_wire_hz == 0)
+    {
+        return;
+    }
+    ns = (uint64_t)bits * DS1307_EMULATOR_SECOND_NS / gs_wire_hz;
+    if (gs_clock == DS1307_EMULATOR_CLOCK_VIRTUAL)
+    {
+        (void)ds1307_emulator_advance(ns);
+        
+        return;
+    }
+    end = ds1307_interface_get_tick_ns() + ns;
+    while (ds1307_interface_get_tick_ns() < end)
+    {
+        
+    }
+}
+
+/**
+ * @brief     store bytes at the register pointer
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @note      none
+ */
+static void a_emulator_store(uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        if (gs_pointer < 8)
+        {
+            gs_reg[gs_pointer] = buf[i] & gs_mask[gs_pointer];
+            if (gs_pointer == 0)
+            {
+                /* writing the seconds restarts the countdown chain */
+                gs_phase_ns = 0;
+            }
+        }
+        else
+        {
+            gs_reg[gs_pointer] = buf[i];
+        }
+        gs_pointer = (uint8_t)((gs_pointer + 1) & 0x3F);
+    }
+}
+
+/**
+ * @brief      load bytes from the register pointer
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @note       none
+ */
+static void a_emulator_load(uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = gs_reg[gs_pointer];
+        gs_pointer = (uint8_t)((gs_pointer + 1) & 0x3F);
+    }
+}
+
+/**
+ * @brief  emulator reset
+ * @return status code
+ *         - 0 success
+ * @note   the register file goes back to the power on state, the clock is virtual,
+ *         the wire time model and the skew are off and the emulator is detached
+ */
+uint8_t ds1307_emulator_reset(void)
+{
+    memset(gs_reg, 0, sizeof(uint8_t) * 64);
+    
+    /* 2000-01-01 00:00:00, week 1, oscillator halted */
+    gs_reg[0] = 0x80;
+    gs_reg[3] = 0x01;
+    gs_reg[4] = 0x01;
+    gs_reg[5] = 0x01;
+    
+    /* sqw off, rs 32.768kHz */
+    gs_reg[7] = 0x03;
+    
+    gs_pointer = 0;
+    gs_attach = 0;
+    gs_clock = DS1307_EMULATOR_CLOCK_VIRTUAL;
+    gs_virtual_ns = DS1307_EMULATOR_START_NS;
+    gs_last_ns = gs_virtual_ns;
+    gs_phase_ns = 0;
+    gs_wire_hz = 0;
+    gs_skew_ppm = 0;
+    gs_sqw_callback = NULL;
+    gs_sqw_busy = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     attach or detach the emulator
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ * @note      an attached emulator replaces the chip behind the interface functions of the port
+ */
+uint8_t ds1307_emulator_set_attach(ds1307_bool_t enable)
+{
+    gs_attach = (uint8_t)enable;
+    
+    return 0;
+}
+
+/**
+ * @brief  get the emulator attach status
+ * @return 1 if attached, 0 if not
+ * @note   none
+ */
+uint8_t ds1307_emulator_get_attach(void)
+{
+    return gs_attach;
+}
+
+/**
+ * @brief     set the emulator clock
+ * @param[in] clock emulator clock
+ * @return    status code
+ *            - 0 success
+ * @note      the chip time is carried over
+ */
+uint8_t ds1307_emulator_set_clock(ds1307_emulator_clock_t clock)
+{
+    a_emulator_update(a_emulator_now());
+    gs_clock = clock;
+    gs_last_ns = a_emulator_now();
+    
+    return 0;
+}
+
+/**
+ * @brief  get the emulator clock
+ * @return emulator clock
+ * @note   none
+ */
+ds1307_emulator_clock_t ds1307_emulator_get_clock(void)
+{
+    return gs_clock;
+}
+
+/**
+ * @brief  get the emulator tick
+ * @return tick in ns
+ * @note   the virtual time or ds1307_interface_get_tick_ns
+ */
+uint64_t ds1307_emulator_get_tick_ns(void)
+{
+    return a_emulator_now();
+}
+
+/**
+ * @brief     advance the virtual time
+ * @param[in] ns nanoseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 the clock is real
+ * @note      the sqw callback runs at every falling edge on the way
+ */
+uint8_t ds1307_emulator_advance(uint64_t ns)
+{
+    uint64_t target;
+    uint64_t edge;
+    
+    if (gs_clock != DS1307_EMULATOR_CLOCK_VIRTUAL)
+    {
+        return 1;
+    }
+    
+    target = gs_virtual_ns + ns;
+    while ((gs_sqw_callback != NULL) && (gs_sqw_busy == 0) && (a_emulator_sqw_next(&edge) == 0) &&
+           (gs_virtual_ns + edge <= target))
+    {
+        /* stop at the edge */
+        gs_virtual_ns += edge;
+        a_emulator_update(gs_virtual_ns);
+        
+        /* the bus time of the callback must not raise nested edges */
+        gs_sqw_busy = 1;
+        (void)gs_sqw_callback();
+        gs_sqw_busy = 0;
+    }
+    gs_virtual_ns = (gs_virtual_ns > target) ? gs_virtual_ns : target;
+    a_emulator_update(gs_virtual_ns);
+    
+    return 0;
+}
+
+/**
+ * @brief     set the wire speed
+ * @param[in] hz iic clock, 0 means transfers take no time
+ * @return    status code
+ *            - 0 success
+ * @note      100000 gives the latency of a standard mode bus, a transfer advances
+ *            the virtual time or spins on the real clock
+ */
+uint8_t ds1307_emulator_set_wire_speed(uint32_t hz)
+{
+    gs_wire_hz = hz;
+    
+    return 0;
+}
+
+/**
+ * @brief     set the crystal skew
+ * @param[in] ppm chain speed error in ppm, positive runs fast
+ * @return    status code
+ *            - 0 success
+ * @note      the countdown chain runs against the emulator clock at this error,
+ *            so a host that reads the chip sees its seconds drift
+ */
+uint8_t ds1307_emulator_set_skew(int32_t ppm)
+{
+    a_emulator_update(a_emulator_now());
+    gs_skew_ppm = ppm;
+    
+    return 0;
+}
+
+/**
+ * @brief     set the sqw callback
+ * @param[in] *callback pointer to a callback function, NULL disables it
+ * @return    status code
+ *            - 0 success
+ * @note      called at every falling edge of SQW/OUT while the virtual time advances
+ */
+uint8_t ds1307_emulator_set_sqw_callback(uint8_t (*callback)(void))
+{
+    gs_sqw_callback = callback;
+    
+    return 0;
+}
+
+/**
+ * @brief      get the SQW/OUT level
+ * @param[out] *level pointer to a level buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the 1Hz falling edge is the seconds update, a halted oscillator stops the square wave low
+ */
+uint8_t ds1307_emulator_get_sqw_level(uint8_t *level)
+{
+    uint32_t f;
+    
+    a_emulator_update(a_emulator_now());
+    if ((gs_reg[7] & (1 << 4)) == 0)
+    {
+        /* static output */
+        *level = (gs_reg[7] >> 7) & 0x01;
+    }
+    else if ((gs_reg[0] & 0x80) != 0)
+    {
+        /* halted */
+        *level = 0;
+    }
+    else
+    {
+        /* low in the first half of every period */
+        f = gs_freq[gs_reg[7] & 0x03];
+        *level = (uint8_t)(((gs_phase_ns * f * 2 / DS1307_EMULATOR_SECOND_NS) & 0x01) != 0);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  emulator iic bus init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t ds1307_emulator_iic_init(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  emulator iic bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t ds1307_emulator_iic_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      emulator iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the time registers are latched at the start, the register pointer wraps from 0x3F to 0x00
+ */
+uint8_t ds1307_emulator_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    /* no ack */
+    if (addr != DS1307_EMULATOR_ADDRESS)
+    {
+        return 1;
+    }
+    
+    /* latch at the start, then the bus time passes */
+    a_emulator_update(a_emulator_now());
+    gs_pointer = reg & 0x3F;
+    a_emulator_load(buf, len);
+    a_emulator_wire(29 + 9 * (uint32_t)len);
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      writing the second register resets the countdown chain,
+ *            the register pointer wraps from 0x3F to 0x00
+ */
+uint8_t ds1307_emulator_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    /* no ack */
+    if (addr != DS1307_EMULATOR_ADDRESS)
+    {
+        return 1;
+    }
+    
+    /* the data lands at the stop */
+    a_emulator_wire(20 + 9 * (uint32_t)len);
+    a_emulator_update(a_emulator_now());
+    gs_pointer = reg & 0x3F;
+    a_emulator_store(buf, len);
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator iic bus transfer of several messages
+ * @param[in] *msg pointer to a message array
+ * @param[in] len message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      a read continues at the register pointer left by the previous message
+ */
+uint8_t ds1307_emulator_iic_transfer(ds1307_iic_msg_t *msg, uint8_t len)
+{
+    uint8_t i;
+    uint32_t bits;
+    
+    /* no ack */
+    for (i = 0; i < len; i++)
+    {
+        if (msg[i].addr != DS1307_EMULATOR_ADDRESS)
+        {
+            return 1;
+        }
+    }
+    
+    /* every message of the transfer sees the same latched time */
+    a_emulator_update(a_emulator_now());
+    bits = 1;
+    for (i = 0; i < len; i++)
+    {
+        if (msg[i].flags == DS1307_IIC_MSG_READ)
+        {
+            a_emulator_load(msg[i].buf, msg[i].len);
+        }
+        else if (msg[i].len != 0)
+        {
+            gs_pointer = msg[i].buf[0] & 0x3F;
+            a_emulator_store(&msg[i].buf[1], (uint16_t)(msg[i].len - 1));
+        }
+        else
+        {
+            
+        }
+        bits += 10 + 9 * (uint32_t)msg[i].len;
+    }
+    a_emulator_wire(bits);
+    
+    return 0;
+}
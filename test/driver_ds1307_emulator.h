@@ -0,0 +1,218 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_emulator.h
+ * @brief     driver ds1307 emulator header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS1307_EMULATOR_H
+#define DRIVER_DS1307_EMULATOR_H
+
+#include "driver_ds1307_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ds1307_test_driver
+ * @{
+ */
+
+/**
+ * @brief ds1307 emulator clock enumeration definition
+ */
+typedef enum
+{
+    DS1307_EMULATOR_CLOCK_VIRTUAL = 0x00,        /**< injected virtual time */
+    DS1307_EMULATOR_CLOCK_REAL    = 0x01,        /**< ds1307_interface_get_tick_ns */
+} ds1307_emulator_clock_t;
+
+/**
+ * @brief  emulator reset
+ * @return status code
+ *         - 0 success
+ * @note   the register file goes back to the power on state, the clock is virtual,
+ *         the wire time model and the skew are off and the emulator is detached
+ */
+uint8_t ds1307_emulator_reset(void);
+
+/**
+ * @brief     attach or detach the emulator
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ * @note      an attached emulator replaces the chip behind the interface functions of the port
+ */
+uint8_t ds1307_emulator_set_attach(ds1307_bool_t enable);
+
+/**
+ * @brief  get the emulator attach status
+ * @return 1 if attached, 0 if not
+ * @note   none
+ */
+uint8_t ds1307_emulator_get_attach(void);
+
+/**
+ * @brief     set the emulator clock
+ * @param[in] clock emulator clock
+ * @return    status code
+ *            - 0 success
+ * @note      the chip time is carried over
+ */
+uint8_t ds1307_emulator_set_clock(ds1307_emulator_clock_t clock);
+
+/**
+ * @brief  get the emulator clock
+ * @return emulator clock
+ * @note   none
+ */
+ds1307_emulator_clock_t ds1307_emulator_get_clock(void);
+
+/**
+ * @brief  get the emulator tick
+ * @return tick in ns
+ * @note   the virtual time or ds1307_interface_get_tick_ns
+ */
+uint64_t ds1307_emulator_get_tick_ns(void);
+
+/**
+ * @brief     advance the virtual time
+ * @param[in] ns nanoseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 the clock is real
+ * @note      the sqw callback runs at every falling edge on the way
+ */
+uint8_t ds1307_emulator_advance(uint64_t ns);
+
+/**
+ * @brief     set the wire speed
+ * @param[in] hz iic clock, 0 means transfers take no time
+ * @return    status code
+ *            - 0 success
+ * @note      100000 gives the latency of a standard mode bus, a transfer advances
+ *            the virtual time or spins on the real clock
+ */
+uint8_t ds1307_emulator_set_wire_speed(uint32_t hz);
+
+/**
+ * @brief     set the crystal skew
+ * @param[in] ppm chain speed error in ppm, positive runs fast
+ * @return    status code
+ *            - 0 success
+ * @note      the countdown chain runs against the emulator clock at this error,
+ *            so a host that reads the chip sees its seconds drift
+ */
+uint8_t ds1307_emulator_set_skew(int32_t ppm);
+
+/**
+ * @brief     set the sqw callback
+ * @param[in] *callback pointer to a callback function, NULL disables it
+ * @return    status code
+ *            - 0 success
+ * @note      called at every falling edge of SQW/OUT while the virtual time advances
+ */
+uint8_t ds1307_emulator_set_sqw_callback(uint8_t (*callback)(void));
+
+/**
+ * @brief      get the SQW/OUT level
+ * @param[out] *level pointer to a level buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the 1Hz falling edge is the seconds update, a halted oscillator stops the square wave low
+ */
+uint8_t ds1307_emulator_get_sqw_level(uint8_t *level);
+
+/**
+ * @brief  emulator iic bus init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t ds1307_emulator_iic_init(void);
+
+/**
+ * @brief  emulator iic bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t ds1307_emulator_iic_deinit(void);
+
+/**
+ * @brief      emulator iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the time registers are latched at the start, the register pointer wraps from 0x3F to 0x00
+ */
+uint8_t ds1307_emulator_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     emulator iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      writing the second register resets the countdown chain,
+ *            the register pointer wraps from 0x3F to 0x00
+ */
+uint8_t ds1307_emulator_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     emulator iic bus transfer of several messages
+ * @param[in] *msg pointer to a message array
+ * @param[in] len message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      a read continues at the register pointer left by the previous message
+ */
+uint8_t ds1307_emulator_iic_transfer(ds1307_iic_msg_t *msg, uint8_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -60,6 +60,9 @@ uint8_t ds1307_output_test(uint32_t times)
     DRIVER_DS1307_LINK_IIC_READ(&gs_handle, ds1307_interface_iic_read);
     DRIVER_DS1307_LINK_IIC_WRITE(&gs_handle, ds1307_interface_iic_write);
     DRIVER_DS1307_LINK_DELAY_MS(&gs_handle, ds1307_interface_delay_ms);
+    DRIVER_DS1307_LINK_GET_TICK_NS(&gs_handle, ds1307_interface_get_tick_ns);
+    DRIVER_DS1307_LINK_STATS_TICK(&gs_handle, ds1307_interface_stats_tick);
+    DRIVER_DS1307_LINK_TRACE(&gs_handle, ds1307_interface_trace);
     DRIVER_DS1307_LINK_DEBUG_PRINT(&gs_handle, ds1307_interface_debug_print);
     
     /* get ds1307 info */
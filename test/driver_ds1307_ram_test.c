@@ -35,9 +35,13 @@
  */
 
 #include "driver_ds1307_ram_test.h"
+#include "driver_ds1307_kv.h"
+#include "driver_ds1307_event.h"
 #include <stdlib.h>
 
 static ds1307_handle_t gs_handle;        /**< ds1307 handle */
+static ds1307_kv_handle_t gs_kv;         /**< ds1307 kv handle */
+static ds1307_event_handle_t gs_event;   /**< ds1307 event handle */
 static uint8_t gs_buf[56];               /**< buffer */
 static uint8_t gs_check_buf[56];         /**< check buffer */
 
@@ -54,6 +58,12 @@ uint8_t ds1307_ram_test(uint32_t times)
     uint8_t res;
     uint32_t i;
     uint8_t j;
+    uint32_t value;
+    uint32_t check;
+    uint8_t len;
+    uint8_t addr;
+    uint8_t record[DS1307_KV_RECORD_SIZE];
+    ds1307_event_t events[3];
     ds1307_info_t info;
     
     /* link functions */
@@ -63,6 +73,9 @@ uint8_t ds1307_ram_test(uint32_t times)
     DRIVER_DS1307_LINK_IIC_READ(&gs_handle, ds1307_interface_iic_read);
     DRIVER_DS1307_LINK_IIC_WRITE(&gs_handle, ds1307_interface_iic_write);
     DRIVER_DS1307_LINK_DELAY_MS(&gs_handle, ds1307_interface_delay_ms);
+    DRIVER_DS1307_LINK_GET_TICK_NS(&gs_handle, ds1307_interface_get_tick_ns);
+    DRIVER_DS1307_LINK_STATS_TICK(&gs_handle, ds1307_interface_stats_tick);
+    DRIVER_DS1307_LINK_TRACE(&gs_handle, ds1307_interface_trace);
     DRIVER_DS1307_LINK_DEBUG_PRINT(&gs_handle, ds1307_interface_debug_print);
     
     /* get ds1307 info */
@@ -153,6 +166,323 @@ uint8_t ds1307_ram_test(uint32_t times)
         ds1307_interface_debug_print("ds1307: %d/%d check passed.\n", i + 1, times);
     }
     
+    /* write back ram cache test */
+    ds1307_interface_debug_print("ds1307: write back ram cache test.\n");
+    
+    /* set write back */
+    res = ds1307_set_ram_cache(&gs_handle, DS1307_RAM_CACHE_WRITE_BACK);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set ram cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* scattered writes */
+    for (j = 0; j < 56; j += 3)
+    {
+        gs_buf[j] = rand() & 0xFF;
+        res = ds1307_write_ram(&gs_handle, j, &gs_buf[j], 1);
+        if (res != 0)
+        {
+            ds1307_interface_debug_print("ds1307: write ram failed.\n");
+            (void)ds1307_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* a register write of a dirty byte reaches the chip and must survive the flush */
+    gs_buf[0] = (uint8_t)(gs_buf[0] ^ 0xFF);
+    res = ds1307_set_reg(&gs_handle, 0x08, &gs_buf[0], 1);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set reg failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* flush ram cache */
+    res = ds1307_flush_ram_cache(&gs_handle);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: flush ram cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable the cache and read the chip */
+    res = ds1307_set_ram_cache(&gs_handle, DS1307_RAM_CACHE_DISABLE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set ram cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_read_ram(&gs_handle, 0x00, gs_check_buf, 56);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: read ram failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* check data */
+    for (j = 0; j < 56; j++)
+    {
+        if (gs_buf[j] != gs_check_buf[j])
+        {
+            ds1307_interface_debug_print("ds1307: check buffer failed.\n");
+            (void)ds1307_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    ds1307_interface_debug_print("ds1307: check write back ram cache ok.\n");
+    
+    /* kv test */
+    ds1307_interface_debug_print("ds1307: kv test.\n");
+    
+    /* init kv */
+    res = ds1307_kv_init(&gs_kv, &gs_handle, 0x00, 56);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: kv init failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* format kv */
+    res = ds1307_kv_format(&gs_kv);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: kv format failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set twice so both records of the pair are used */
+    value = rand();
+    res = ds1307_kv_set(&gs_kv, 0x01, value + 1);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: kv set failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_kv_set(&gs_kv, 0x01, value);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: kv set failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: kv set key 1 0x%08X.\n", value);
+    
+    /* rebuild the index from the chip */
+    res = ds1307_kv_init(&gs_kv, &gs_handle, 0x00, 56);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: kv init failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_kv_get(&gs_kv, 0x01, &check);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: kv get failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: kv get key 1 0x%08X.\n", check);
+    ds1307_interface_debug_print("ds1307: check kv value %s.\n", (check == value) ? "ok" : "error");
+    if (check != value)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a torn commit overwrites only a prefix of the older record of the pair */
+    addr = (uint8_t)((2 * gs_kv.index[0x01] + (gs_kv.slot[gs_kv.index[0x01]] ^ 1)) * DS1307_KV_RECORD_SIZE);
+    record[0] = 0x01;
+    record[1] = (uint8_t)(gs_kv.seq[gs_kv.index[0x01]] + 1);
+    record[2] = (uint8_t)(~value >> 0);
+    record[3] = (uint8_t)(~value >> 8);
+    record[4] = (uint8_t)(~value >> 16);
+    record[5] = (uint8_t)(~value >> 24);
+    for (len = 1; len < DS1307_KV_RECORD_SIZE; len++)
+    {
+        res = ds1307_write_ram(&gs_handle, addr, record, len);
+        if (res != 0)
+        {
+            ds1307_interface_debug_print("ds1307: write ram failed.\n");
+            (void)ds1307_deinit(&gs_handle);
+            
+            return 1;
+        }
+        res = ds1307_kv_init(&gs_kv, &gs_handle, 0x00, 56);
+        if (res != 0)
+        {
+            ds1307_interface_debug_print("ds1307: kv init failed.\n");
+            (void)ds1307_deinit(&gs_handle);
+            
+            return 1;
+        }
+        res = ds1307_kv_get(&gs_kv, 0x01, &check);
+        if ((res != 0) || (check != value))
+        {
+            ds1307_interface_debug_print("ds1307: check kv torn record %d bytes error.\n", len);
+            (void)ds1307_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    ds1307_interface_debug_print("ds1307: check kv torn record ok.\n");
+    
+    /* delete the key */
+    res = ds1307_kv_delete(&gs_kv, 0x01);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: kv delete failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_kv_init(&gs_kv, &gs_handle, 0x00, 56);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: kv init failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_kv_get(&gs_kv, 0x01, &check);
+    ds1307_interface_debug_print("ds1307: check kv delete %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)ds1307_kv_deinit(&gs_kv);
+    
+    /* event test */
+    ds1307_interface_debug_print("ds1307: event test.\n");
+    
+    /* init event */
+    res = ds1307_event_init(&gs_event, &gs_handle, 0x00, 56);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: event init failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* clear event */
+    res = ds1307_event_clear(&gs_event);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: event clear failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* append events */
+    for (j = 0; j < 3; j++)
+    {
+        res = ds1307_event_append(&gs_event, (uint8_t)(j + 1));
+        if (res != 0)
+        {
+            ds1307_interface_debug_print("ds1307: event append failed.\n");
+            (void)ds1307_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* read events */
+    len = 3;
+    res = ds1307_event_read(&gs_event, events, &len);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: event read failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (j = 0; j < len; j++)
+    {
+        ds1307_interface_debug_print("ds1307: event %d code %d epoch %d.\n", j, events[j].code, events[j].epoch);
+    }
+    res = ((len == 3) && (events[0].code == 1) && (events[2].code == 3)) ? 0 : 1;
+    ds1307_interface_debug_print("ds1307: check event %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)ds1307_event_deinit(&gs_event);
+    
+    /* a broken magic must start an empty ring */
+    gs_buf[0] = DS1307_EVENT_MAGIC ^ 0xFF;
+    res = ds1307_write_ram(&gs_handle, 0x00, gs_buf, 1);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: write ram failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_event_init(&gs_event, &gs_handle, 0x00, 56);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: event init failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    len = 3;
+    res = ds1307_event_read(&gs_event, events, &len);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: event read failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_read_ram(&gs_handle, 0x00, gs_check_buf, 1);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: read ram failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ((len == 0) && (gs_check_buf[0] == DS1307_EVENT_MAGIC)) ? 0 : 1;
+    ds1307_interface_debug_print("ds1307: check event header %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)ds1307_event_deinit(&gs_event);
+    
     /* finish ram test */
     ds1307_interface_debug_print("ds1307: finish ram test.\n");
     (void)ds1307_deinit(&gs_handle);
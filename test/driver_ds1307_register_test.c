@@ -38,6 +38,13 @@
 #include <stdlib.h>
 
 static ds1307_handle_t gs_handle;        /**< ds1307 handle */
+static ds1307_transaction_t gs_tr;       /**< ds1307 transaction */
+#if (DS1307_CONFIG_STATS != 0)
+static ds1307_stats_t gs_stats;          /**< ds1307 stats */
+#endif
+#if (DS1307_CONFIG_LOG_BINARY != 0) && (DS1307_CONFIG_CHECK != 0)
+static ds1307_log_entry_t gs_log[8];     /**< ds1307 log ring */
+#endif
 
 /**
  * @brief  register test
@@ -56,6 +63,29 @@ uint8_t ds1307_register_test(void)
     ds1307_output_level_t level;
     ds1307_output_mode_t mode;
     ds1307_square_wave_frequency_t freq;
+    ds1307_output_config_t config_in;
+    ds1307_output_config_t config_out;
+    uint8_t profile;
+    uint32_t ms;
+    uint32_t epoch_in;
+    uint32_t epoch_out;
+    ds1307_raw_time_t raw;
+    uint16_t field;
+    int8_t order;
+    uint8_t second;
+    ds1307_snapshot_t snapshot;
+    uint64_t tick;
+    uint8_t i;
+    uint8_t ram_in[8];
+    uint8_t ram_out[8];
+#if (DS1307_CONFIG_STATS != 0)
+    uint32_t count;
+#endif
+#if (DS1307_CONFIG_LOG_BINARY != 0) && (DS1307_CONFIG_CHECK != 0)
+    ds1307_log_entry_t entry[2];
+    uint32_t len;
+    uint32_t lost;
+#endif
     
     /* link functions */
     DRIVER_DS1307_LINK_INIT(&gs_handle, ds1307_handle_t);
@@ -64,6 +94,9 @@ uint8_t ds1307_register_test(void)
     DRIVER_DS1307_LINK_IIC_READ(&gs_handle, ds1307_interface_iic_read);
     DRIVER_DS1307_LINK_IIC_WRITE(&gs_handle, ds1307_interface_iic_write);
     DRIVER_DS1307_LINK_DELAY_MS(&gs_handle, ds1307_interface_delay_ms);
+    DRIVER_DS1307_LINK_GET_TICK_NS(&gs_handle, ds1307_interface_get_tick_ns);
+    DRIVER_DS1307_LINK_STATS_TICK(&gs_handle, ds1307_interface_stats_tick);
+    DRIVER_DS1307_LINK_TRACE(&gs_handle, ds1307_interface_trace);
     DRIVER_DS1307_LINK_DEBUG_PRINT(&gs_handle, ds1307_interface_debug_print);
     
     /* get ds1307 info */
@@ -177,6 +210,103 @@ uint8_t ds1307_register_test(void)
     }
     ds1307_interface_debug_print("ds1307: check time %s.\n", (memcmp((uint8_t *)&time_in, (uint8_t *)&time_out, sizeof(ds1307_time_t)) == 0) ? "ok" : "error");
     
+    /* ds1307_set_epoch/ds1307_get_epoch test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_epoch/ds1307_get_epoch test.\n");
+    
+    epoch_in = 946684800UL + (uint32_t)(rand() % 100) * 31536000UL + (uint32_t)(rand() % 86400);
+    ds1307_interface_debug_print("ds1307: set epoch %u.\n", epoch_in);
+    res = ds1307_set_epoch(&gs_handle, epoch_in);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set epoch failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_epoch(&gs_handle, &epoch_out);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get epoch failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check epoch %s.\n", (epoch_in == epoch_out) ? "ok" : "error");
+    
+    /* ds1307_get_raw_time test */
+    ds1307_interface_debug_print("ds1307: ds1307_get_raw_time test.\n");
+    
+    res = ds1307_get_raw_time(&gs_handle, &raw);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get raw time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_time(&gs_handle, &time_in);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)ds1307_raw_time_decode(&raw, &time_out);
+    ds1307_interface_debug_print("ds1307: check raw time decode %s.\n", ((time_in.year == time_out.year) && (time_in.month == time_out.month) &&
+                                 (time_in.date == time_out.date) && (time_in.hour == time_out.hour)) ? "ok" : "error");
+    (void)ds1307_raw_time_get_field(&raw, DS1307_RAW_FIELD_YEAR, &field);
+    ds1307_interface_debug_print("ds1307: check raw time field %s.\n", (field == time_in.year) ? "ok" : "error");
+    (void)ds1307_raw_time_compare(&raw, &raw, &order);
+    ds1307_interface_debug_print("ds1307: check raw time compare %s.\n", (order == 0) ? "ok" : "error");
+    
+    /* ds1307_get_second/ds1307_get_time_of_day/ds1307_get_date test */
+    ds1307_interface_debug_print("ds1307: ds1307_get_second/ds1307_get_time_of_day/ds1307_get_date test.\n");
+    
+    res = ds1307_get_time_of_day(&gs_handle, &time_out);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time of day failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_date(&gs_handle, &time_out);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get date failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check time of day and date %s.\n", ((time_in.year == time_out.year) && (time_in.month == time_out.month) &&
+                                 (time_in.date == time_out.date) && (time_in.week == time_out.week) && (time_in.hour == time_out.hour) &&
+                                 (time_in.minute == time_out.minute)) ? "ok" : "error");
+    res = ds1307_get_second(&gs_handle, &second, &enable);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get second failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)ds1307_get_elapsed_second(time_in.second, second, &second);
+    ds1307_interface_debug_print("ds1307: check second %s.\n", (second < 2) ? "ok" : "error");
+    (void)ds1307_get_elapsed_second(58, 2, &second);
+    ds1307_interface_debug_print("ds1307: check elapsed second %s.\n", (second == 4) ? "ok" : "error");
+    time_in.format = DS1307_FORMAT_12H;
+    time_in.am_pm = DS1307_PM;
+    time_in.hour = 11;
+    time_in.minute = 59;
+    time_in.second = 50;
+    time_out.format = DS1307_FORMAT_24H;
+    time_out.am_pm = DS1307_AM;
+    time_out.hour = 0;
+    time_out.minute = 0;
+    time_out.second = 5;
+    (void)ds1307_get_elapsed_time_of_day(&time_in, &time_out, &ms);
+    ds1307_interface_debug_print("ds1307: check elapsed time of day %s.\n", (ms == 15) ? "ok" : "error");
+    
     /* ds1307_set_oscillator/ds1307_get_oscillator test */
     ds1307_interface_debug_print("ds1307: ds1307_set_oscillator/ds1307_get_oscillator test.\n");
     
@@ -421,6 +551,571 @@ uint8_t ds1307_register_test(void)
     }
     ds1307_interface_debug_print("ds1307: check square wave frequency %s.\n", (freq == DS1307_SQUARE_WAVE_FREQUENCY_32768_HZ) ? "ok" : "error");
     
+    /* ds1307_set_output_config/ds1307_get_output_config test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_output_config/ds1307_get_output_config test.\n");
+    
+    /* set output config */
+    config_in.level = (ds1307_output_level_t)(rand() % 2);
+    config_in.mode = (ds1307_output_mode_t)(rand() % 2);
+    config_in.freq = (ds1307_square_wave_frequency_t)(rand() % 4);
+    res = ds1307_set_output_config(&gs_handle, &config_in);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set output config failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: set output config level %d mode %d freq %d.\n", config_in.level, config_in.mode, config_in.freq);
+    res = ds1307_get_output_config(&gs_handle, &config_out);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get output config failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check output config %s.\n", (memcmp((uint8_t *)&config_in, (uint8_t *)&config_out, sizeof(ds1307_output_config_t)) == 0) ? "ok" : "error");
+    
+    /* ds1307_set_output_profile/ds1307_get_output_profile test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_output_profile/ds1307_get_output_profile test.\n");
+    
+    /* save output profile */
+    res = ds1307_get_output_profile(&gs_handle, &profile);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get output profile failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: save output profile 0x%02X.\n", profile);
+    
+    /* change output config */
+    res = ds1307_set_output_level(&gs_handle, (ds1307_output_level_t)(!config_in.level));
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set output level failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* restore output profile */
+    res = ds1307_set_output_profile(&gs_handle, profile);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set output profile failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: restore output profile 0x%02X.\n", profile);
+    res = ds1307_get_output_config(&gs_handle, &config_out);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get output config failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check output profile %s.\n", (memcmp((uint8_t *)&config_in, (uint8_t *)&config_out, sizeof(ds1307_output_config_t)) == 0) ? "ok" : "error");
+    
+    /* ds1307_set_register_cache/ds1307_get_register_cache test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_register_cache/ds1307_get_register_cache test.\n");
+    
+    /* enable register cache */
+    res = ds1307_set_register_cache(&gs_handle, DS1307_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set register cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: enable register cache.\n");
+    res = ds1307_get_register_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get register cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check register cache %s.\n", (enable == DS1307_BOOL_TRUE) ? "ok" : "error");
+    
+    /* set output level high through the cache */
+    res = ds1307_set_output_level(&gs_handle, DS1307_OUTPUT_LEVEL_HIGH);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set output level failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* refresh register cache */
+    res = ds1307_refresh_register_cache(&gs_handle);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: refresh register cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: refresh register cache.\n");
+    res = ds1307_get_output_level(&gs_handle, &level);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get output level failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check output level %s.\n", (level == DS1307_OUTPUT_LEVEL_HIGH) ? "ok" : "error");
+    
+    /* invalidate register cache */
+    res = ds1307_invalidate_register_cache(&gs_handle);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: invalidate register cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: invalidate register cache.\n");
+    res = ds1307_get_square_wave_frequency(&gs_handle, &freq);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get square wave frequency failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check square wave frequency %s.\n", (freq == config_in.freq) ? "ok" : "error");
+    
+    /* disable register cache */
+    res = ds1307_set_register_cache(&gs_handle, DS1307_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set register cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: disable register cache.\n");
+    res = ds1307_get_register_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get register cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check register cache %s.\n", (enable == DS1307_BOOL_FALSE) ? "ok" : "error");
+    
+    /* ds1307_set_time_cache/ds1307_get_time_cache test */
+    ds1307_interface_debug_print("ds1307: ds1307_set_time_cache/ds1307_get_time_cache test.\n");
+    
+    /* set time cache interval */
+    res = ds1307_set_time_cache_interval(&gs_handle, 1000);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set time cache interval failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: set time cache interval 1000ms.\n");
+    res = ds1307_get_time_cache_interval(&gs_handle, &ms);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time cache interval failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check time cache interval %s.\n", (ms == 1000) ? "ok" : "error");
+    
+    /* enable time cache */
+    res = ds1307_set_time_cache(&gs_handle, DS1307_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set time cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: enable time cache.\n");
+    res = ds1307_get_time_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check time cache %s.\n", (enable == DS1307_BOOL_TRUE) ? "ok" : "error");
+    
+    /* cached time, a 24H read reports bit 5 of the hour register as am pm */
+    time_in.format = DS1307_FORMAT_24H;
+    time_in.year = rand() % 100 + 2000;
+    time_in.month = rand() % 12 + 1;
+    time_in.date = rand() % 20 + 1;
+    time_in.week = rand() % 7 + 1;
+    time_in.hour = rand() % 24;
+    time_in.am_pm = (time_in.hour >= 20) ? DS1307_PM : DS1307_AM;
+    time_in.minute = rand() % 60;
+    time_in.second = rand() % 50;
+    ds1307_interface_debug_print("ds1307: set time %04d-%02d-%02d %02d:%02d:%02d %d.\n",
+                                 time_in.year, time_in.month, time_in.date,
+                                 time_in.hour, time_in.minute, time_in.second, time_in.week
+                                );
+    res  = ds1307_set_time(&gs_handle, &time_in);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_refresh_time_cache(&gs_handle);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: refresh time cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: refresh time cache.\n");
+    res = ds1307_get_time(&gs_handle, &time_out);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check cached time %s.\n", (memcmp((uint8_t *)&time_in, (uint8_t *)&time_out, sizeof(ds1307_time_t)) == 0) ? "ok" : "error");
+    
+    /* disable time cache */
+    res = ds1307_set_time_cache(&gs_handle, DS1307_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set time cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: disable time cache.\n");
+    res = ds1307_get_time_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time cache failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check time cache %s.\n", (enable == DS1307_BOOL_FALSE) ? "ok" : "error");
+    
+    /* ds1307_get_last_time test */
+    ds1307_interface_debug_print("ds1307: ds1307_get_last_time test.\n");
+    
+    /* get time publishes it */
+    res = ds1307_get_time(&gs_handle, &time_in);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_last_time(&gs_handle, &time_out, &tick);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get last time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check last time %s.\n", (memcmp((uint8_t *)&time_in, (uint8_t *)&time_out, sizeof(ds1307_time_t)) == 0) ? "ok" : "error");
+    
+    /* ds1307_snapshot/ds1307_bind_snapshot test */
+    ds1307_interface_debug_print("ds1307: ds1307_snapshot/ds1307_bind_snapshot test.\n");
+    
+    /* run the clock while the snapshot is bound */
+    res = ds1307_set_oscillator(&gs_handle, DS1307_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set oscillator failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* snapshot */
+    res = ds1307_snapshot(&gs_handle, &snapshot);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: snapshot failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_bind_snapshot(&gs_handle, &snapshot);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: bind snapshot failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: bind snapshot.\n");
+    
+    /* the snapshot time is frozen */
+    res = ds1307_get_time(&gs_handle, &time_in);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_epoch(&gs_handle, &epoch_in);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get epoch failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_delay_ms(1100);
+    res = ds1307_get_time(&gs_handle, &time_out);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check snapshot time %s.\n", (memcmp((uint8_t *)&time_in, (uint8_t *)&time_out, sizeof(ds1307_time_t)) == 0) ? "ok" : "error");
+    
+    /* writes update the snapshot */
+    res = ds1307_set_square_wave_frequency(&gs_handle, DS1307_SQUARE_WAVE_FREQUENCY_4096_HZ);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set square wave frequency failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_square_wave_frequency(&gs_handle, &freq);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get square wave frequency failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check snapshot write %s.\n", (freq == DS1307_SQUARE_WAVE_FREQUENCY_4096_HZ) ? "ok" : "error");
+    
+    /* a read-modify-write must not write the stale snapshot seconds back */
+    res = ds1307_set_oscillator(&gs_handle, DS1307_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set oscillator failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* unbind */
+    res = ds1307_bind_snapshot(&gs_handle, NULL);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: bind snapshot failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: unbind snapshot.\n");
+    res = ds1307_get_square_wave_frequency(&gs_handle, &freq);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get square wave frequency failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check chip write %s.\n", (freq == DS1307_SQUARE_WAVE_FREQUENCY_4096_HZ) ? "ok" : "error");
+    res = ds1307_get_epoch(&gs_handle, &epoch_out);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get epoch failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check snapshot read-modify-write %s.\n", (epoch_out > epoch_in) ? "ok" : "error");
+    res = ds1307_set_oscillator(&gs_handle, DS1307_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set oscillator failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* ds1307_transaction test */
+    ds1307_interface_debug_print("ds1307: ds1307_transaction test.\n");
+    
+    /* queue write control, write ram, read control, read ram and read time */
+    config_in.level = DS1307_OUTPUT_LEVEL_HIGH;
+    config_in.mode = DS1307_OUTPUT_MODE_LEVEL;
+    config_in.freq = DS1307_SQUARE_WAVE_FREQUENCY_8192_HZ;
+    for (i = 0; i < 8; i++)
+    {
+        ram_in[i] = rand() & 0xFF;
+    }
+    res = ds1307_transaction_begin(&gs_handle, &gs_tr);
+    res |= ds1307_transaction_write_control(&gs_tr, &config_in);
+    res |= ds1307_transaction_write_ram(&gs_tr, 0, ram_in, 8);
+    res |= ds1307_transaction_read_control(&gs_tr, &config_out);
+    res |= ds1307_transaction_read_ram(&gs_tr, 0, ram_out, 8);
+    res |= ds1307_transaction_read_time(&gs_tr, &time_out);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: transaction queue failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* commit one by one */
+    res = ds1307_transaction_commit(&gs_tr);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: transaction commit failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check transaction control %s.\n", (memcmp((uint8_t *)&config_in, (uint8_t *)&config_out, sizeof(ds1307_output_config_t)) == 0) ? "ok" : "error");
+    ds1307_interface_debug_print("ds1307: check transaction ram %s.\n", (memcmp(ram_in, ram_out, 8) == 0) ? "ok" : "error");
+    ds1307_interface_debug_print("ds1307: transaction time %04d-%02d-%02d %02d:%02d:%02d.\n",
+                                 time_out.year, time_out.month, time_out.date,
+                                 time_out.hour, time_out.minute, time_out.second);
+    
+    /* commit in one transfer */
+    DRIVER_DS1307_LINK_IIC_TRANSFER(&gs_handle, ds1307_interface_iic_transfer);
+    memset(&config_out, 0, sizeof(ds1307_output_config_t));
+    memset(ram_out, 0, 8);
+    res = ds1307_transaction_commit(&gs_tr);
+    DRIVER_DS1307_LINK_IIC_TRANSFER(&gs_handle, NULL);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: transaction commit failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check transfer control %s.\n", (memcmp((uint8_t *)&config_in, (uint8_t *)&config_out, sizeof(ds1307_output_config_t)) == 0) ? "ok" : "error");
+    ds1307_interface_debug_print("ds1307: check transfer ram %s.\n", (memcmp(ram_in, ram_out, 8) == 0) ? "ok" : "error");
+    ds1307_interface_debug_print("ds1307: transfer time %04d-%02d-%02d %02d:%02d:%02d.\n",
+                                 time_out.year, time_out.month, time_out.date,
+                                 time_out.hour, time_out.minute, time_out.second);
+    
+#if (DS1307_CONFIG_STATS != 0)
+    /* ds1307_get_stats/ds1307_reset_stats test */
+    ds1307_interface_debug_print("ds1307: ds1307_get_stats/ds1307_reset_stats test.\n");
+    
+    /* one raw read */
+    res = ds1307_reset_stats(&gs_handle);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: reset stats failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_reg(&gs_handle, 0x08, ram_out, 8);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get reg failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_stats(&gs_handle, &gs_stats);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get stats failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    count = 0;
+    for (i = 0; i < DS1307_STATS_BUCKET_NUM; i++)
+    {
+        count += gs_stats.op[DS1307_STATS_OP_REG].histogram[i];
+    }
+    ds1307_interface_debug_print("ds1307: check stats counter %s.\n", ((gs_stats.op[DS1307_STATS_OP_REG].transaction == 1) &&
+                                 (gs_stats.op[DS1307_STATS_OP_REG].byte_in == 8) && (gs_stats.op[DS1307_STATS_OP_REG].byte_out == 1) &&
+                                 (gs_stats.op[DS1307_STATS_OP_REG].error == 0) && (gs_stats.op[DS1307_STATS_OP_GET_TIME].transaction == 0)) ? "ok" : "error");
+    ds1307_interface_debug_print("ds1307: check stats histogram %s.\n", (count == 1) ? "ok" : "error");
+    
+    /* reset */
+    res = ds1307_reset_stats(&gs_handle);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: reset stats failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_stats(&gs_handle, &gs_stats);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get stats failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check stats reset %s.\n", (gs_stats.op[DS1307_STATS_OP_REG].transaction == 0) ? "ok" : "error");
+    
+#endif
+#if (DS1307_CONFIG_LOG_BINARY != 0) && (DS1307_CONFIG_CHECK != 0)
+    /* ds1307_log_read test */
+    ds1307_interface_debug_print("ds1307: ds1307_log_read test.\n");
+    
+    /* link the log ring */
+    DRIVER_DS1307_LINK_LOG_BUFFER(&gs_handle, gs_log, 8);
+    
+    /* one invalid address */
+    res = ds1307_read_ram(&gs_handle, 60, ram_out, 1);
+    if (res != 4)
+    {
+        ds1307_interface_debug_print("ds1307: read ram failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    len = 2;
+    res = ds1307_log_read(&gs_handle, entry, &len, &lost);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: log read failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: check log ring %s.\n", ((len == 1) && (lost == 0) && (entry[0].seq == 1) &&
+                                 (entry[0].id == DS1307_LOG_ADDR_IS_INVALID) && (entry[0].arg == 60)) ? "ok" : "error");
+    
+    /* unlink the log ring */
+    DRIVER_DS1307_LINK_LOG_BUFFER(&gs_handle, NULL, 0);
+    
+#endif
     /* finish register test */
     ds1307_interface_debug_print("ds1307: finish register test.\n");
     (void)ds1307_deinit(&gs_handle);
@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds1307_sqw_test.c
+ * @brief     driver ds1307 sqw test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-05-31
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/05/31  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds1307_sqw_test.h"
+
+static ds1307_handle_t gs_handle;        /**< ds1307 handle */
+
+/**
+ * @brief  sqw test irq handler
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+uint8_t ds1307_sqw_test_irq_handler(void)
+{
+    if (ds1307_sqw_irq_handler(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     sqw test
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+uint8_t ds1307_sqw_test(uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t ns;
+    uint64_t now;
+    uint64_t last;
+    uint64_t diff;
+    ds1307_time_t t;
+    ds1307_time_t chip;
+    ds1307_info_t info;
+    
+    /* link functions */
+    DRIVER_DS1307_LINK_INIT(&gs_handle, ds1307_handle_t);
+    DRIVER_DS1307_LINK_IIC_INIT(&gs_handle, ds1307_interface_iic_init);
+    DRIVER_DS1307_LINK_IIC_DEINIT(&gs_handle, ds1307_interface_iic_deinit);
+    DRIVER_DS1307_LINK_IIC_READ(&gs_handle, ds1307_interface_iic_read);
+    DRIVER_DS1307_LINK_IIC_WRITE(&gs_handle, ds1307_interface_iic_write);
+    DRIVER_DS1307_LINK_DELAY_MS(&gs_handle, ds1307_interface_delay_ms);
+    DRIVER_DS1307_LINK_GET_TICK_NS(&gs_handle, ds1307_interface_get_tick_ns);
+    DRIVER_DS1307_LINK_STATS_TICK(&gs_handle, ds1307_interface_stats_tick);
+    DRIVER_DS1307_LINK_TRACE(&gs_handle, ds1307_interface_trace);
+    DRIVER_DS1307_LINK_DEBUG_PRINT(&gs_handle, ds1307_interface_debug_print);
+    
+    /* get ds1307 info */
+    res = ds1307_info(&info);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get info failed.\n");
+       
+        return 1;
+    }
+    else
+    {
+        /* print ds1307 info */
+        ds1307_interface_debug_print("ds1307: chip is %s.\n", info.chip_name);
+        ds1307_interface_debug_print("ds1307: manufacturer is %s.\n", info.manufacturer_name);
+        ds1307_interface_debug_print("ds1307: interface is %s.\n", info.interface);
+        ds1307_interface_debug_print("ds1307: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        ds1307_interface_debug_print("ds1307: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        ds1307_interface_debug_print("ds1307: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        ds1307_interface_debug_print("ds1307: max current is %0.2fmA.\n", info.max_current_ma);
+        ds1307_interface_debug_print("ds1307: max temperature is %0.1fC.\n", info.temperature_max);
+        ds1307_interface_debug_print("ds1307: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start sqw test */
+    ds1307_interface_debug_print("ds1307: start sqw test.\n");
+    
+    /* init ds1307 */
+    res = ds1307_init(&gs_handle);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set oscillator */
+    res = ds1307_set_oscillator(&gs_handle, DS1307_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set oscillator failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* enable sqw discipline */
+    res = ds1307_set_sqw_discipline(&gs_handle, DS1307_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set sqw discipline failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* wait for the first edge */
+    ds1307_interface_debug_print("ds1307: wait for the sqw edge.\n");
+    ds1307_interface_delay_ms(1500);
+    
+    /* loop */
+    last = 0;
+    for (i = 0; i < times; i++)
+    {
+        /* get sqw time */
+        res = ds1307_get_sqw_time(&gs_handle, &t, &ns);
+        if (res != 0)
+        {
+            ds1307_interface_debug_print("ds1307: get sqw time failed.\n");
+            (void)ds1307_set_sqw_discipline(&gs_handle, DS1307_BOOL_FALSE);
+            (void)ds1307_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ds1307_interface_debug_print("ds1307: sqw time %04d-%02d-%02d %02d:%02d:%02d.%06d.\n",
+                                     t.year, t.month, t.date, t.hour, t.minute, t.second, ns / 1000
+                                    );
+        
+        /* check the step */
+        now = ((uint64_t)t.hour * 3600 + (uint64_t)t.minute * 60 + t.second) * 1000000000ULL + ns;
+        if (i != 0)
+        {
+            diff = (now + 86400ULL * 1000000000ULL - last) % (86400ULL * 1000000000ULL);
+            ds1307_interface_debug_print("ds1307: check sqw time %s.\n", ((diff > 900000000ULL) && (diff < 1500000000ULL)) ? "ok" : "error");
+        }
+        last = now;
+        
+        /* delay 1000ms */
+        ds1307_interface_delay_ms(1000);
+    }
+    
+    /* set time while anchored */
+    t.format = DS1307_FORMAT_24H;
+    t.am_pm = DS1307_AM;
+    t.year = 2030;
+    t.month = 6;
+    t.date = 15;
+    t.week = 6;
+    t.hour = 20;
+    t.minute = 30;
+    t.second = 0;
+    res = ds1307_set_time(&gs_handle, &t);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set time failed.\n");
+        (void)ds1307_set_sqw_discipline(&gs_handle, DS1307_BOOL_FALSE);
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_delay_ms(1500);
+    res = ds1307_get_sqw_time(&gs_handle, &t, &ns);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get sqw time failed.\n");
+        (void)ds1307_set_sqw_discipline(&gs_handle, DS1307_BOOL_FALSE);
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds1307_get_time(&gs_handle, &chip);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: get time failed.\n");
+        (void)ds1307_set_sqw_discipline(&gs_handle, DS1307_BOOL_FALSE);
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds1307_interface_debug_print("ds1307: sqw time %04d-%02d-%02d %02d:%02d:%02d after set time.\n",
+                                 t.year, t.month, t.date, t.hour, t.minute, t.second
+                                );
+    now = (uint64_t)t.hour * 3600 + (uint64_t)t.minute * 60 + t.second;
+    last = (uint64_t)chip.hour * 3600 + (uint64_t)chip.minute * 60 + chip.second;
+    ds1307_interface_debug_print("ds1307: check sqw time after set time %s.\n",
+                                 ((t.year == chip.year) && (t.month == chip.month) && (t.date == chip.date) &&
+                                 (last - now <= 1)) ? "ok" : "error");
+    
+    /* disable sqw discipline */
+    res = ds1307_set_sqw_discipline(&gs_handle, DS1307_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds1307_interface_debug_print("ds1307: set sqw discipline failed.\n");
+        (void)ds1307_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish sqw test */
+    ds1307_interface_debug_print("ds1307: finish sqw test.\n");
+    (void)ds1307_deinit(&gs_handle);
+    
+    return 0;
+}